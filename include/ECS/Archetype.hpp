@@ -0,0 +1,357 @@
+/*
+** EPITECH PROJECT, 2024
+** B-CPP-500-LIL-5-2-rtype-ewen.sellitto
+** File description:
+** Archetype.hpp
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "BaseQuery.hpp"
+#include "Components.hpp"
+#include "Entity.hpp"
+#include "Storage.hpp"
+#include "Utilities.hpp"
+
+namespace ECS
+{
+    /**
+     * @class Archetype
+     * @brief Table holding every entity that owns exactly the same set of components.
+     *
+     * @note Each component type of the signature has its own column, rows of all the columns are aligned with the
+     * entity list so the components of an entity are found at the same index in every column.
+     * @note Columns hold plain pointers, the components are owned by their entity. Tags have no column, they only
+     * live in the signature.
+     */
+    class Archetype
+    {
+        public:
+            /**
+             * @brief Construct a new Archetype object.
+             *
+             * @param signature The component types of the entities stored in this archetype.
+             */
+            explicit Archetype(const Signature &signature) : _signature(signature), _types(), _columns()
+            {
+                _columnIndex.fill(npos);
+                _addEdges.fill(nullptr);
+                _removeEdges.fill(nullptr);
+                for (type_t type = 0; type < _signature.size(); type++) {
+                    if (!_signature.test(type) || TagRegistry::isTag(type)) continue;
+                    _columnIndex[type] = _types.size();
+                    _types.push_back(type);
+                }
+                _columns.resize(_types.size());
+            }
+
+            ~Archetype() = default;
+
+            /*=================//
+            //  Rows Handling  //
+            //=================*/
+
+            /**
+             * @brief Append an entity and its components at the end of the table.
+             *
+             * @param entity The entity to append, it must own every component of the signature.
+             * @return std::size_t The row of the entity.
+             */
+            std::size_t push(Entity *entity)
+            {
+                auto &components = entity->getComponents();
+
+                for (std::size_t i = 0; i < _types.size(); i++)
+                    _columns[i].push_back(components[_types[i]].get());
+                _entities.push_back(entity);
+                return _entities.size() - 1;
+            }
+
+            /**
+             * @brief Remove a row by moving the last row in its place.
+             *
+             * @param row The row to remove.
+             * @return Entity * The entity now stored at this row, nullptr if the removed row was the last one.
+             */
+            Entity *swapRemove(std::size_t row)
+            {
+                std::size_t last = _entities.size() - 1;
+
+                if (row != last) {
+                    _entities[row] = _entities[last];
+                    for (auto &column : _columns)
+                        column[row] = std::move(column[last]);
+                }
+                _entities.pop_back();
+                for (auto &column : _columns)
+                    column.pop_back();
+                return row != last ? _entities[row] : nullptr;
+            }
+
+            /*===================//
+            //  Getters/Setters  //
+            //===================*/
+
+            /**
+             * @brief Check if the archetype stores all the given component types.
+             *
+             * @tparam Types The component types to look for.
+             * @return bool True if every type has a column in this archetype.
+             */
+            template <typename... Types> bool matches() const
+            {
+                return Utils::matches(_signature, Utils::getSignature<Types...>());
+            }
+
+            bool hasColumn(type_t type) const
+            {
+                return _columnIndex[type] != npos;
+            }
+
+            std::size_t getColumnIndex(type_t type) const
+            {
+                return _columnIndex[type];
+            }
+
+            std::vector<BaseComponent *> &getColumn(std::size_t index)
+            {
+                return _columns[index];
+            }
+
+            std::vector<Entity *> &getEntities()
+            {
+                return _entities;
+            }
+
+            const Signature &getSignature() const
+            {
+                return _signature;
+            }
+
+            std::size_t size() const
+            {
+                return _entities.size();
+            }
+
+            /**
+             * @brief Get the cached archetype reached by adding (or removing) a component type to this one.
+             *
+             * @param type The type identifier of the component added (or removed).
+             * @return Archetype *& The slot of the transition, null if it was not resolved yet.
+             */
+            Archetype *&getAddEdge(type_t type)
+            {
+                return _addEdges[type];
+            }
+
+            Archetype *&getRemoveEdge(type_t type)
+            {
+                return _removeEdges[type];
+            }
+
+            /**
+             * @brief Flag telling that some rows were emptied during an iteration and still have to be compacted.
+             */
+            bool hasHoles = false;
+
+        private:
+            static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+            Signature                                   _signature;
+            std::vector<type_t>                         _types;
+            std::array<std::size_t, ECS_MAX_COMPONENTS> _columnIndex;
+            std::vector<std::vector<BaseComponent *>>   _columns;
+            std::vector<Entity *>                       _entities;
+            std::array<Archetype *, ECS_MAX_COMPONENTS> _addEdges;
+            std::array<Archetype *, ECS_MAX_COMPONENTS> _removeEdges;
+    };
+
+    /**
+     * @class ArchetypeStorage
+     * @brief Storage backend grouping entities by component signature.
+     *
+     * @note Queries only visit the archetypes holding every requested component, and read the components straight
+     * from the archetype columns instead of probing the component map of every entity. Since entities only move
+     * between existing tables, queries just need to be told about new archetypes to stay up to date.
+     * @warning Structural changes made while an iteration is running (adding or removing components, destroying
+     * entities) are applied to the entities right away but the tables are only updated once the outermost iteration
+     * ends, so an entity is never visited twice by the same iteration.
+     */
+    class ArchetypeStorage : public BaseStorage
+    {
+        public:
+            ArchetypeStorage() : _archetypes(), _archetypeList(), _pending(), _queries() {}
+
+            ~ArchetypeStorage() override = default;
+
+            /*===================//
+            //  Entity Tracking  //
+            //===================*/
+
+            void insert(Entity *entity) override
+            {
+                Archetype *archetype = getArchetype(entity->getSignature());
+
+                entity->_storage   = this;
+                entity->_archetype = archetype;
+                entity->_row       = archetype->push(entity);
+            }
+
+            void erase(Entity *entity) override
+            {
+                if (entity->_archetype == nullptr) return;
+                if (isLocked()) {
+                    entity->_archetype->getEntities()[entity->_row] = nullptr;
+                    entity->_archetype->hasHoles                   = true;
+                    if (entity->_pendingMove) _pending.erase(std::find(_pending.begin(), _pending.end(), entity));
+                } else {
+                    detach(entity);
+                }
+                entity->_archetype   = nullptr;
+                entity->_pendingMove = false;
+            }
+
+            void onComponentAdded(Entity *entity, type_t type) override
+            {
+                if (deferMove(entity)) return syncColumn(entity, type);
+
+                Archetype *&target = entity->_archetype->getAddEdge(type);
+
+                if (target == nullptr) {
+                    target                      = getArchetype(entity->getSignature());
+                    target->getRemoveEdge(type) = entity->_archetype;
+                }
+                move(entity, target);
+            }
+
+            void onComponentRemoved(Entity *entity, type_t type) override
+            {
+                if (deferMove(entity)) return syncColumn(entity, type);
+
+                Archetype *&target = entity->_archetype->getRemoveEdge(type);
+
+                if (target == nullptr) {
+                    target                   = getArchetype(entity->getSignature());
+                    target->getAddEdge(type) = entity->_archetype;
+                }
+                move(entity, target);
+            }
+
+            void addQuery(BaseQuery *query) override
+            {
+                _queries.push_back(query);
+                for (Archetype *archetype : _archetypeList)
+                    query->onArchetypeCreated(archetype);
+            }
+
+            /**
+             * @brief Get the archetypes of the storage.
+             *
+             * @return std::vector<Archetype *> & every archetype, in creation order.
+             */
+            std::vector<Archetype *> &getArchetypes()
+            {
+                return _archetypeList;
+            }
+
+        private:
+            /**
+             * @brief Find the archetype of a signature, creating it if needed.
+             */
+            Archetype *getArchetype(const Signature &signature)
+            {
+                auto it = _archetypes.find(signature);
+
+                if (it != _archetypes.end()) return it->second.get();
+
+                auto       archetype = std::make_unique<Archetype>(signature);
+                Archetype *ptr       = archetype.get();
+
+                _archetypes.emplace(signature, std::move(archetype));
+                _archetypeList.push_back(ptr);
+                for (BaseQuery *query : _queries)
+                    query->onArchetypeCreated(ptr);
+                return ptr;
+            }
+
+            /**
+             * @brief Remember that an entity changed while iterating instead of moving it.
+             *
+             * @return bool True if the move was deferred.
+             */
+            bool deferMove(Entity *entity)
+            {
+                if (!isLocked()) return false;
+                if (!entity->_pendingMove) {
+                    entity->_pendingMove = true;
+                    _pending.push_back(entity);
+                }
+                return true;
+            }
+
+            /**
+             * @brief Point the column of a component at the current component of an entity whose move is deferred.
+             *
+             * @param entity The entity, still in its old archetype.
+             * @param type The type identifier of the added or removed component.
+             * @note A removed component is already destroyed and a component added back may get another block from
+             * ComponentAllocator, so the row must not keep the old pointer until the move.
+             */
+            static void syncColumn(Entity *entity, type_t type)
+            {
+                Archetype *archetype = entity->_archetype;
+
+                if (!archetype->hasColumn(type)) return;
+                archetype->getColumn(archetype->getColumnIndex(type))[entity->_row] =
+                    type < entity->_components.size() ? entity->_components[type].get() : nullptr;
+            }
+
+            /**
+             * @brief Remove an entity from its archetype, keeping the row of the moved entity up to date.
+             */
+            static void detach(Entity *entity)
+            {
+                Entity *moved = entity->_archetype->swapRemove(entity->_row);
+
+                if (moved != nullptr) moved->_row = entity->_row;
+            }
+
+            void move(Entity *entity, Archetype *target)
+            {
+                if (target == entity->_archetype) return;
+                detach(entity);
+                entity->_archetype = target;
+                entity->_row       = target->push(entity);
+            }
+
+            void flush() override
+            {
+                for (Archetype *archetype : _archetypeList) {
+                    if (!archetype->hasHoles) continue;
+                    for (std::size_t row = archetype->size(); row-- > 0;) {
+                        if (archetype->getEntities()[row] != nullptr) continue;
+                        Entity *moved = archetype->swapRemove(row);
+                        if (moved != nullptr) moved->_row = row;
+                    }
+                    archetype->hasHoles = false;
+                }
+                for (Entity *entity : _pending) {
+                    entity->_pendingMove = false;
+                    move(entity, getArchetype(entity->getSignature()));
+                }
+                _pending.clear();
+            }
+
+            std::unordered_map<Signature, std::unique_ptr<Archetype>> _archetypes;
+            std::vector<Archetype *>                                  _archetypeList;
+            std::vector<Entity *>                                     _pending;
+            std::vector<BaseQuery *>                                  _queries;
+    };
+} // namespace ECS
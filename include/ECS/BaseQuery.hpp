@@ -0,0 +1,116 @@
+/*
+** EPITECH PROJECT, 2024
+** B-CPP-500-LIL-5-2-rtype-ewen.sellitto
+** File description:
+** BaseQuery.hpp
+*/
+
+#pragma once
+
+#include "Entity.hpp"
+#include "EntitySet.hpp"
+#include "Utilities.hpp"
+
+namespace ECS
+{
+    class Archetype;
+
+    /**
+     * @class BaseQuery
+     * @brief Abstract base class for the persistent queries of a World.
+     *
+     * @note The storage backend keeps its queries up to date: the archetype storage tells them about every new
+     * archetype, while the sparse set storage updates their set of matching entities whenever a component is added or
+     * removed.
+     */
+    class BaseQuery
+    {
+        public:
+            /**
+             * @brief Construct a new BaseQuery object.
+             *
+             * @param signature The component types required by the query.
+             */
+            explicit BaseQuery(const Signature &signature) : _signature(signature), _members() {}
+
+            /**
+             * @brief Virtual destructor for BaseQuery.
+             */
+            virtual ~BaseQuery() = default;
+
+            /**
+             * @brief Check if a signature holds every component required by the query.
+             *
+             * @param signature The signature of an entity or an archetype.
+             * @return bool True if the signature matches the query.
+             */
+            bool matches(const Signature &signature) const
+            {
+                return Utils::matches(signature, _signature);
+            }
+
+            /**
+             * @brief Notify the query that the storage created an archetype.
+             *
+             * @param archetype The new archetype, the query keeps it if it holds every required component.
+             */
+            virtual void onArchetypeCreated(Archetype *archetype) = 0;
+
+            /*====================//
+            //  Members Handling  //
+            //====================*/
+
+            /**
+             * @brief Add or remove an entity from the matching entities after its components changed.
+             *
+             * @param entity The entity that changed.
+             * @param deferred True if an iteration is running, removed entities then keep their slot until compact().
+             */
+            void update(Entity *entity, bool deferred)
+            {
+                bool member = _members.contains(entity->getId());
+
+                if (matches(entity->getSignature())) {
+                    if (!member) _members.insert(entity->getId(), entity);
+                } else if (member) {
+                    remove(entity, deferred);
+                }
+            }
+
+            /**
+             * @brief Remove an entity from the matching entities.
+             *
+             * @param entity The entity to remove.
+             * @param deferred True if an iteration is running, the entity then keeps its slot until compact().
+             */
+            void remove(Entity *entity, bool deferred)
+            {
+                if (!_members.contains(entity->getId())) return;
+                if (deferred)
+                    _members.tombstone(entity->getId());
+                else
+                    _members.erase(entity->getId(), [](std::size_t, std::size_t) {});
+            }
+
+            /**
+             * @brief Remove the slots left by the entities removed during an iteration.
+             */
+            void compact()
+            {
+                if (_members.hasHoles) _members.compact([](std::size_t, std::size_t) {});
+            }
+
+            /*===================//
+            //  Getters/Setters  //
+            //===================*/
+
+            const Signature &getSignature() const
+            {
+                return _signature;
+            }
+
+        protected:
+            Signature _signature;
+            EntitySet _members;
+    };
+} // namespace ECS
@@ -0,0 +1,161 @@
+/*
+** EPITECH PROJECT, 2024
+** B-CPP-500-LIL-5-2-rtype-ewen.sellitto
+** File description:
+** CommandBuffer.hpp
+*/
+
+#pragma once
+
+#include <limits>
+#include <vector>
+
+#include "Components.hpp"
+#include "Entity.hpp"
+#include "Utilities.hpp"
+
+namespace ECS
+{
+    /**
+     * @class CommandBuffer
+     * @brief Records structural changes (entities and components added or removed) to apply them later.
+     *
+     * @note Each thread records into its own buffer (see World::commands()), the World plays every buffer back at its
+     * sync points: before each stage of systems. Iterations never see the entities or components change under them,
+     * and systems running on several threads can still make structural changes.
+     * @note Buffers are played back in thread order, then the buffers of the systems of a parallel stage in system
+     * order, and the commands of a buffer in the order they were recorded.
+     */
+    class CommandBuffer
+    {
+            friend class World;
+
+        public:
+            CommandBuffer() : _commands() {}
+
+            /**
+             * @brief Destroy the CommandBuffer object, and the components it still holds.
+             */
+            ~CommandBuffer()
+            {
+                clear();
+            }
+
+            CommandBuffer &operator=(const CommandBuffer &buffer) = delete;
+            CommandBuffer(const CommandBuffer &buffer)            = delete;
+
+            /*===================//
+            //  Entity Commands  //
+            //===================*/
+
+            /**
+             * @brief Record the creation of an entity with a set of components.
+             *
+             * @tparam Components The component types to add to the entity.
+             * @param components The components to add, created with 'new', the buffer takes their ownership.
+             * @note The id of the entity is only known once the buffer is played back.
+             */
+            template <typename... Components> void createEntity(Components *...components)
+            {
+                _commands.push_back({CommandType::CreateEntity, 0, nullptr, false, nullptr});
+                (addComponent(createdEntity, components), ...);
+            }
+
+            /**
+             * @brief Record the destruction of an entity.
+             *
+             * @param id The unique identifier of the entity, ignored if it no longer exists at playback.
+             */
+            void destroyEntity(id_t id)
+            {
+                _commands.push_back({CommandType::DestroyEntity, id, nullptr, false, nullptr});
+            }
+
+            /*======================//
+            //  Component Commands  //
+            //======================*/
+
+            /**
+             * @brief Record the addition of a component to an entity.
+             *
+             * @tparam T Type of the component.
+             * @param id The unique identifier of the entity, the component is destroyed if it no longer exists at
+             * playback.
+             * @param component The component to add, created with 'new', the buffer takes its ownership.
+             */
+            template <typename T> void addComponent(id_t id, T *component)
+            {
+                _commands.push_back({CommandType::AddComponent, id, component, false, &applyAddComponent<T>});
+            }
+
+            /**
+             * @brief Record the removal of a component from an entity.
+             *
+             * @tparam T Type of the component.
+             * @param id The unique identifier of the entity, ignored if it no longer exists at playback.
+             * @param needToDelete True to tell the clients about the removal, see Entity::removeComponent().
+             */
+            template <typename T> void removeComponent(id_t id, bool needToDelete = false)
+            {
+                _commands.push_back(
+                    {CommandType::RemoveComponent, id, nullptr, needToDelete, &applyRemoveComponent<T>});
+            }
+
+            /*===================//
+            //  Getters/Setters  //
+            //===================*/
+
+            bool empty() const
+            {
+                return _commands.empty();
+            }
+
+            std::size_t size() const
+            {
+                return _commands.size();
+            }
+
+            /**
+             * @brief Drop every recorded command without applying it.
+             */
+            void clear()
+            {
+                for (Command &command : _commands)
+                    delete command.component;
+                _commands.clear();
+            }
+
+        private:
+            /**
+             * @brief Entity id of the commands targeting the entity created by the previous CreateEntity command.
+             */
+            static constexpr id_t createdEntity = std::numeric_limits<id_t>::max();
+
+            enum class CommandType {
+                CreateEntity,
+                DestroyEntity,
+                AddComponent,
+                RemoveComponent,
+            };
+
+            struct Command {
+                    CommandType    type;
+                    id_t           entity;
+                    BaseComponent *component;
+                    bool           needToDelete;
+                    void (*apply)(Entity &, const Command &);
+            };
+
+            template <typename T> static void applyAddComponent(Entity &entity, const Command &command)
+            {
+                entity.addComponent(static_cast<T *>(command.component));
+            }
+
+            template <typename T> static void applyRemoveComponent(Entity &entity, const Command &command)
+            {
+                entity.removeComponent<T>(command.needToDelete);
+            }
+
+            std::vector<Command> _commands;
+    };
+} // namespace ECS
@@ -0,0 +1,138 @@
+/*
+** EPITECH PROJECT, 2024
+** B-CPP-500-LIL-5-2-rtype-ewen.sellitto
+** File description:
+** ComponentAllocator.hpp
+*/
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+#ifndef ECS_POOL_SLAB_SIZE    // Number of blocks a size class of the component allocator takes from the heap at
+#define ECS_POOL_SLAB_SIZE 64 // once when it runs out of free blocks
+#endif                        // !ECS_POOL_SLAB_SIZE
+
+#ifndef ECS_POOL_MAX_SIZE     // Size in bytes of the biggest component served by the component allocator, bigger
+#define ECS_POOL_MAX_SIZE 512 // components are allocated on the heap
+#endif                        // !ECS_POOL_MAX_SIZE
+
+namespace ECS
+{
+    /**
+     * @class ComponentAllocator
+     * @brief Pools of fixed size blocks the components are allocated from.
+     *
+     * @note BaseComponent routes its operator new/delete here, so 'new XComponent()' takes a block from the free list
+     * of its size class and deleting the component gives the block back: spawning and destroying entities reuses the
+     * same memory instead of going through the heap. Each size class grows by slabs of ECS_POOL_SLAB_SIZE blocks.
+     * Entity does the same for the entities.
+     * @note The pools are shared by every World, since components are created before being added to an entity. Use
+     * World::reserveComponents() to fill them ahead of a burst of spawns.
+     * @note Thread safe, each size class has its own lock.
+     */
+    class ComponentAllocator
+    {
+        public:
+            /**
+             * @brief Get a block for a component.
+             *
+             * @param size The size of the component, in bytes.
+             * @return void * The block, aligned on alignof(std::max_align_t).
+             * @throw std::bad_alloc if the heap is exhausted.
+             */
+            static void *allocate(std::size_t size)
+            {
+                if (size == 0 || size > ECS_POOL_MAX_SIZE) return ::operator new(size);
+
+                SizeClass                  &sizeClass = getSizeClass(size);
+                std::lock_guard<std::mutex> lock(sizeClass.mutex);
+
+                if (!sizeClass.freeList) grow(sizeClass, getBlockSize(size), ECS_POOL_SLAB_SIZE);
+                Block *block       = sizeClass.freeList;
+                sizeClass.freeList = block->next;
+                return block;
+            }
+
+            /**
+             * @brief Give back the block of a destroyed component.
+             *
+             * @param ptr The block, returned by allocate().
+             * @param size The size given to allocate().
+             */
+            static void deallocate(void *ptr, std::size_t size) noexcept
+            {
+                if (!ptr) return;
+                if (size == 0 || size > ECS_POOL_MAX_SIZE) return ::operator delete(ptr);
+
+                SizeClass                  &sizeClass = getSizeClass(size);
+                std::lock_guard<std::mutex> lock(sizeClass.mutex);
+
+                sizeClass.freeList = new (ptr) Block{sizeClass.freeList};
+            }
+
+            /**
+             * @brief Make sure a size class holds enough free blocks.
+             *
+             * @param size The size of the components, in bytes.
+             * @param count The number of components to allocate without growing the size class.
+             */
+            static void reserve(std::size_t size, std::size_t count)
+            {
+                if (size == 0 || size > ECS_POOL_MAX_SIZE) return;
+
+                SizeClass                  &sizeClass = getSizeClass(size);
+                std::lock_guard<std::mutex> lock(sizeClass.mutex);
+                std::size_t                 available = 0;
+
+                for (Block *block = sizeClass.freeList; block && available < count; block = block->next)
+                    available++;
+                if (available < count) grow(sizeClass, getBlockSize(size), count - available);
+            }
+
+        private:
+            static constexpr std::size_t blockAlignment = alignof(std::max_align_t);
+
+            struct Block {
+                    Block *next;
+            };
+
+            struct SizeClass {
+                    std::mutex                                mutex;
+                    Block                                    *freeList = nullptr;
+                    std::vector<std::unique_ptr<std::byte[]>> slabs;
+            };
+
+            static std::size_t getBlockSize(std::size_t size)
+            {
+                return (size + blockAlignment - 1) / blockAlignment * blockAlignment;
+            }
+
+            /**
+             * @brief Get the size class serving a size.
+             *
+             * @note The size classes are never destroyed: components owned by static objects (the engine, its
+             * worlds...) may be destroyed after them at exit.
+             */
+            static SizeClass &getSizeClass(std::size_t size)
+            {
+                static auto &sizeClasses = *new std::array<SizeClass, ECS_POOL_MAX_SIZE / blockAlignment + 1>();
+
+                return sizeClasses[getBlockSize(size) / blockAlignment];
+            }
+
+            static void grow(SizeClass &sizeClass, std::size_t blockSize, std::size_t count)
+            {
+                std::unique_ptr<std::byte[]> slab(new std::byte[blockSize * count]);
+
+                for (std::size_t i = count; i > 0; i--)
+                    sizeClass.freeList = new (slab.get() + (i - 1) * blockSize) Block{sizeClass.freeList};
+                sizeClass.slabs.push_back(std::move(slab));
+            }
+    };
+} // namespace ECS
@@ -7,10 +7,16 @@
 
 #pragma once
 
+#include <array>
+#include <cstddef>
 #include <iostream>
 #include <memory>
+#include <new>
+#include <type_traits>
 #include <vector>
 
+#include "ComponentAllocator.hpp"
+#include "Utilities.hpp"
 #include "public/ComponentsType.hpp"
 
 namespace ECS
@@ -29,23 +35,164 @@ namespace ECS
              */
             virtual ~BaseComponent() = default;
 
+            /*=====================//
+            //  Memory Management  //
+            //=====================*/
+
+            /**
+             * @brief Allocate a component from the pool of its size, see ComponentAllocator.
+             */
+            static void *operator new(std::size_t size)
+            {
+                return ComponentAllocator::allocate(size);
+            }
+
+            static void operator delete(void *ptr, std::size_t size) noexcept
+            {
+                ComponentAllocator::deallocate(ptr, size);
+            }
+
+            /**
+             * @brief Over-aligned components are not pooled.
+             */
+            static void *operator new(std::size_t size, std::align_val_t alignment)
+            {
+                return ::operator new(size, alignment);
+            }
+
+            static void operator delete(void *ptr, std::size_t size, std::align_val_t alignment) noexcept
+            {
+                ::operator delete(ptr, size, alignment);
+            }
+
+            /**
+             * @brief Placement new, hidden by the class-specific operator new otherwise.
+             */
+            static void *operator new(std::size_t, void *place) noexcept
+            {
+                return place;
+            }
+
             virtual std::vector<char>   serialize()                                                            = 0;
             virtual ECS::BaseComponent *deserialize(std::vector<char> vec, ECS::BaseComponent *comp = nullptr) = 0;
 
             virtual ComponentType getType() = 0;
 
-            void setHasChanged(bool hasChanged)
+            /**
+             * @brief Stamp the component as written during a change tick.
+             *
+             * @param tick The change tick of the storage of the entity, see BaseStorage::getChangeTick().
+             * @note Done by the entity when the component is added or fetched for writing.
+             */
+            void setChangeTick(std::size_t tick)
+            {
+                _changeTick = tick;
+            }
+
+            std::size_t getChangeTick() const
             {
-                _hasChanged = hasChanged;
+                return _changeTick;
             }
 
-            bool hasChanged() const
+            /**
+             * @brief Check if the component was written after a tick.
+             *
+             * @param tick The tick returned by the last call of the consumer to BaseStorage::markChangeTick(), 0 to
+             * get every component.
+             * @return bool True if the component was added or written since then.
+             * @note Every consumer (network replication, rendering...) keeps its own tick, so each one sees every
+             * change once.
+             */
+            bool hasChangedSince(std::size_t tick) const
             {
-                return _hasChanged;
+                return _changeTick > tick;
             }
 
         private:
-            bool _hasChanged = true;
+            std::size_t _changeTick = 0;
+    };
+
+    /**
+     * @struct Tag
+     * @brief Base of the tag components: empty marker types stored as a bit of the entity signature only.
+     *
+     * @tparam Type The type the tag is replicated as over the network, NoneComponent keeps the tag local.
+     * @note Declare a tag with `struct EnemyTag : ECS::Tag<ComponentType::EnemyComponent> {};` and add it with
+     * Entity::addTag(). A tag costs no allocation, no component object and no storage column, and is checked and
+     * queried like a component.
+     */
+    template <ComponentType Type = ComponentType::NoneComponent> struct Tag {
+            static constexpr ComponentType componentType = Type;
+    };
+
+    /**
+     * @class TagRegistry
+     * @brief Records which component type identifiers are tags, for the storages and the network replication.
+     */
+    class TagRegistry
+    {
+        public:
+            /**
+             * @brief Get the type identifier of a tag, registering it on first use.
+             *
+             * @tparam T The tag type, an empty type (see Tag).
+             * @return type_t The identifier of the tag, from the same family as the components (ECS_TYPEID).
+             */
+            template <typename T> static type_t getId()
+            {
+                static_assert(std::is_empty_v<T>, "Tags must be empty types, see ECS::Tag");
+                static const type_t id = add(ECS_TYPEID(T), T::componentType);
+
+                return id;
+            }
+
+            static bool isTag(type_t type)
+            {
+                return type < ECS_MAX_COMPONENTS && getSignature().test(type);
+            }
+
+            /**
+             * @brief Get the signature of every tag type registered so far.
+             */
+            static const Signature &getSignature()
+            {
+                return tags();
+            }
+
+            /**
+             * @brief Get the type a tag is replicated as.
+             *
+             * @param type The identifier of the tag.
+             * @return ComponentType The network type of the tag, NoneComponent for local tags.
+             */
+            static ComponentType getComponentType(type_t type)
+            {
+                return componentTypes()[type];
+            }
+
+        private:
+            static type_t add(type_t type, ComponentType componentType)
+            {
+                if (type < ECS_MAX_COMPONENTS) {
+                    tags().set(type);
+                    componentTypes()[type] = componentType;
+                }
+                return type;
+            }
+
+            static Signature &tags()
+            {
+                static Signature signature;
+
+                return signature;
+            }
+
+            static std::array<ComponentType, ECS_MAX_COMPONENTS> &componentTypes()
+            {
+                static std::array<ComponentType, ECS_MAX_COMPONENTS> types{};
+
+                return types;
+            }
     };
 
     /**
@@ -53,6 +200,9 @@ namespace ECS
      * @brief Template class to handle components.(when getting a component from an entity, you get a component handle)
      *
      * @tparam T The type of the component this handle is for.
+     * @note The handle does not own the component, it is a plain pointer so copying it and accessing the component
+     * costs no reference counting.
+     * @warning The handle is only valid as long as the component stays on its entity, do not keep it across frames.
      */
     template <typename T> class ComponentHandle
     {
@@ -67,7 +217,14 @@ namespace ECS
              *
              * @param component Pointer to the component.
              */
-            explicit ComponentHandle(std::shared_ptr<T> component) : _component(component){};
+            explicit ComponentHandle(T *component) : _component(component){};
+
+            /**
+             * @brief Constructor initializing the component handle with a component owned elsewhere.
+             *
+             * @param component Pointer to the component, the handle does not take a share of its ownership.
+             */
+            explicit ComponentHandle(const std::shared_ptr<T> &component) : _component(component.get()){};
 
             /**
              * @brief Default destructor.
@@ -85,17 +242,17 @@ namespace ECS
              */
             T *operator()() const
             {
-                return _component.get();
+                return _component;
             }
 
             /**
              * @brief Overloading dereference operator to get the underlying component.
              *
-             * @return T* Pointer to the component.
+             * @return T& Reference to the component.
              */
-            std::shared_ptr<T> operator*()
+            T &operator*() const
             {
-                return get();
+                return *_component;
             }
 
             /**
@@ -103,9 +260,9 @@ namespace ECS
              *
              * @return T* Pointer to the component.
              */
-            std::shared_ptr<T> operator->()
+            T *operator->() const
             {
-                return get();
+                return _component;
             }
 
             /**
@@ -177,17 +334,7 @@ namespace ECS
             }
 
         private:
-            std::shared_ptr<T> _component; ///< Pointer to the component.
-
-            /**
-             * @brief Get the underlying component pointer.
-             *
-             * @return T* Pointer to the component.
-             */
-            std::shared_ptr<T> get()
-            {
-                return _component;
-            }
+            T *_component; ///< Pointer to the component, owned by its entity.
     };
 
 } // namespace ECS
@@ -7,20 +7,27 @@
 
 #pragma once
 
+#include <atomic>
 #include <ctime>
 #include <memory>
+#include <stdexcept>
 #include <sys/types.h>
-#include <unordered_map>
 #include <vector>
 
 #include "Clock.hpp"
+#include "ComponentAllocator.hpp"
 #include "Components.hpp"
+#include "Storage.hpp"
 #include "Utilities.hpp"
 
 namespace ECS
 {
 
     class World;
+    class Archetype;
+    class ArchetypeStorage;
+    class SparseSetStorage;
+    template <typename... Types> class Query;
 
     /**
      * @class Entity
@@ -31,6 +38,9 @@ namespace ECS
     class Entity
     {
             friend class World;
+            friend class ArchetypeStorage;
+            friend class SparseSetStorage;
+            template <typename... Types> friend class Query;
 
         public:
             /**
@@ -40,8 +50,8 @@ namespace ECS
              * @note The Entity will be destroyed when the World is destroyed.
              * @warning Only create an Entity with a World.
              */
-            explicit Entity() : _components(), _componentsToDelete(), _clock(), _id(0){};
-            explicit Entity(ECS::id_t id) : _components(), _componentsToDelete(), _clock(), _id(id){};
+            explicit Entity() : _components(), _signature(), _componentsToDelete(), _clock(), _id(0){};
+            explicit Entity(ECS::id_t id) : _components(), _signature(), _componentsToDelete(), _clock(), _id(id){};
 
             /**
              * @brief Destroy the Entity object.
@@ -53,9 +63,30 @@ namespace ECS
              */
             ~Entity()
             {
-                removeAllComponents();
+                if (_storage) {
+                    trackComponents(false);
+                    _storage->erase(this);
+                }
+                _components.clear();
             };
 
+            /*=====================//
+            //  Memory Management  //
+            //=====================*/
+
+            /**
+             * @brief Allocate an entity from the pool of its size, see ComponentAllocator.
+             */
+            static void *operator new(std::size_t size)
+            {
+                return ComponentAllocator::allocate(size);
+            }
+
+            static void operator delete(void *ptr, std::size_t size) noexcept
+            {
+                ComponentAllocator::deallocate(ptr, size);
+            }
+
             /**
              * @brief set the id of the entity
              * @param id the id to set
@@ -79,12 +110,27 @@ namespace ECS
              * @brief and deletes the sent references
              * @tparam T Type of the component.
              * @param component Component to add, passed as an rvalue.
-             * @throw std::runtime_error if the component already exists.
+             * @throw std::runtime_error if there are more component types than ECS_MAX_COMPONENTS.
              * @warning Meant to be called by the user and the World.
              */
             template <typename T> void addComponent(T *component)
             {
-                _components.emplace(ECS_TYPEID(T), std::shared_ptr<T>(component));
+                std::unique_ptr<T> ptr(component);
+                type_t             type = ECS_TYPEID(T);
+
+                if (type >= ECS_MAX_COMPONENTS)
+                    throw std::runtime_error("Entity::addComponent: more component types than ECS_MAX_COMPONENTS");
+                if (type >= _components.size()) _components.resize(type + 1);
+                if (_components[type]) return;
+                if (MemoryStats::getComponentSize(type) == 0)
+                    MemoryStats::registerComponent(type, sizeof(T), ptr->getType());
+                _components[type] = std::move(ptr);
+                _signature.set(type);
+                if (_storage) {
+                    _storage->onComponentAdded(this, type);
+                    _storage->trackComponent(type, true);
+                    markChanged(type);
+                }
             }
 
             /**
@@ -95,14 +141,55 @@ namespace ECS
              */
             template <typename T> void removeComponent(bool needToDelete = false)
             {
-                auto index = ECS_TYPEID(T);
-                auto it    = _components.find(index);
-                if (it != _components.end()) {
-                    if (needToDelete) _componentsToDelete.push_back(it->second->getType());
-                    _components.erase(it);
+                type_t type = ECS_TYPEID(T);
+
+                if (type < _components.size() && _components[type]) {
+                    if (needToDelete) _componentsToDelete.push_back(_components[type]->getType());
+                    _components[type].reset();
+                    _signature.reset(type);
+                    if (_storage) {
+                        _storage->onComponentRemoved(this, type);
+                        _storage->trackComponent(type, false);
+                    }
+                }
+            }
+
+            /**
+             * @brief Add a tag to the Entity.
+             * @tparam T Type of the tag, an empty type (see Tag).
+             * @throw std::runtime_error if there are more component types than ECS_MAX_COMPONENTS.
+             * @note Only sets the bit of the tag in the signature, no component is created.
+             */
+            template <typename T> void addTag()
+            {
+                type_t type = TagRegistry::getId<T>();
+
+                if (type >= ECS_MAX_COMPONENTS)
+                    throw std::runtime_error("Entity::addTag: more component types than ECS_MAX_COMPONENTS");
+                if (_signature.test(type)) return;
+                _signature.set(type);
+                if (_storage) {
+                    _storage->onComponentAdded(this, type);
+                    markChanged(type);
                 }
             }
 
+            /**
+             * @brief Remove a tag.
+             * @tparam T Type of the tag.
+             * @param needToDelete True to tell the clients about the removal, like removeComponent().
+             */
+            template <typename T> void removeTag(bool needToDelete = false)
+            {
+                type_t type = TagRegistry::getId<T>();
+
+                if (type >= ECS_MAX_COMPONENTS || !_signature.test(type)) return;
+                if (needToDelete && T::componentType != ComponentType::NoneComponent)
+                    _componentsToDelete.push_back(T::componentType);
+                _signature.reset(type);
+                if (_storage) _storage->onComponentRemoved(this, type);
+            }
+
             /**
              * @brief Remove all components.
              * @throw std::out_of_range if a component does not exist.
@@ -110,7 +197,13 @@ namespace ECS
              */
             void removeAllComponents()
             {
+                if (_storage) {
+                    trackComponents(false);
+                    _storage->erase(this);
+                }
                 _components.clear();
+                _signature.reset();
+                if (_storage) _storage->insert(this);
             }
 
             /**
@@ -118,32 +211,46 @@ namespace ECS
              * @tparam T Type of the component.
              * @return ComponentHandle<T> Handle to the component.
              * @throw std::out_of_range if the component does not exist.
+             * @note Pass modifiedComponent to stamp the component with the current change tick, so the consumers of
+             * changes (see BaseComponent::hasChangedSince()) see the write.
              * @note You should not destroy the component.
+             * @note Components are stored under the identifier of their type, a static_cast is enough to get them back.
              */
             template <typename T> ComponentHandle<T> getComponent(bool modifiedComponent = false)
             {
-                auto baseComponentPtr = _components.at(ECS_TYPEID(T));
+                type_t type = ECS_TYPEID(T);
 
-                if (modifiedComponent) baseComponentPtr->setHasChanged(true);
-                std::shared_ptr<T> specificComponentPtr = std::dynamic_pointer_cast<T>(baseComponentPtr);
-                return ComponentHandle<T>(specificComponentPtr);
+                if (type >= _components.size() || !_components[type])
+                    throw std::out_of_range("Entity::getComponent: the entity does not have this component");
+                if (modifiedComponent) markChanged(type);
+                return ComponentHandle<T>(static_cast<T *>(_components[type].get()));
             }
 
             /**
              * @brief Get a list of components.
-             * @return std::unordered_map<id_t, std::shared_ptr<BaseComponent>>
-             * @throw std::out_of_range if a component does not exist.
+             * @return std::vector<std::unique_ptr<BaseComponent>> & The components indexed by their type identifier
+             * (ECS_TYPEID), slots of the types the entity does not have are null.
              * @note You should not destroy the components.
              */
-            std::unordered_map<id_t, std::shared_ptr<BaseComponent>> &getComponents(bool modifiedComponent = false)
+            std::vector<std::unique_ptr<BaseComponent>> &getComponents(bool modifiedComponent = false)
             {
                 if (!modifiedComponent) return _components;
 
-                for (auto &component : _components)
-                    component.second->setHasChanged(true);
+                for (type_t type = 0; type < _signature.size(); type++) {
+                    if (_signature.test(type)) markChanged(type);
+                }
                 return _components;
             }
 
+            /**
+             * @brief Get the last change tick a tag was added to the entity.
+             * @return std::size_t The tick, compare it like BaseComponent::hasChangedSince() does.
+             */
+            std::size_t getTagsChangeTick() const
+            {
+                return _tagsChangeTick.load(std::memory_order_relaxed);
+            }
+
             /**
              * @brief Get components to delete
              * @return
@@ -156,26 +263,24 @@ namespace ECS
             }
 
             /**
-             * @brief Check if the Entity has a component of a specific type.
-             * @tparam T Type of the component.
-             * @return bool True if the component exists, false otherwise.
+             * @brief Check if the Entity has a list of components (or tags).
+             * @tparam T First component type to check.
+             * @tparam Types Other component types to check.
+             * @return bool True if all specified components exist, false otherwise.
+             * @note A single AND-and-compare on the signature of the entity, whatever the number of types.
              */
-            template <typename T> bool has() const
+            template <typename T, typename... Types> bool has() const
             {
-                if (_components.empty()) return false;
-                return _components.find(ECS_TYPEID(T)) != _components.end();
+                return Utils::matches(_signature, Utils::getSignature<T, Types...>());
             }
 
             /**
-             * @brief Check if the Entity has a list of components.
-             * @tparam T First component type to check.
-             * @tparam Types Other component types to check.
-             * @return bool True if all specified components exist, false otherwise.
-             * @throw std::out_of_range if a component does not exist.
+             * @brief Get the signature of the entity.
+             * @return const Signature & The set of the component types owned by the entity.
              */
-            template <typename T, typename V, typename... Types> bool has() const
+            const Signature &getSignature() const
             {
-                return has<T>() && has<V, Types...>();
+                return _signature;
             }
 
             /**
@@ -188,10 +293,49 @@ namespace ECS
             }
 
         private:
-            std::unordered_map<id_t, std::shared_ptr<BaseComponent>> _components;
-            std::vector<ComponentType>                               _componentsToDelete;
-            Clock                                                    _clock;
-            ECS::id_t                                                _id;
+            /**
+             * @brief Stamp a component with the current change tick of the storage.
+             *
+             * @param type The type identifier of the component or the tag, the entity must own it.
+             * @note Entities outside of a World have no change tick, their components get stamped when inserted.
+             * @note Tags have no component to stamp, the entity keeps a single tick for all of them.
+             */
+            void markChanged(type_t type)
+            {
+                if (!_storage) return;
+
+                std::size_t tick = _storage->getChangeTick();
+
+                if (type < _components.size() && _components[type])
+                    _components[type]->setChangeTick(tick);
+                else
+                    _tagsChangeTick.store(tick, std::memory_order_relaxed);
+                _storage->onComponentChanged(type);
+                if (_changeTick.exchange(tick, std::memory_order_relaxed) != tick) _storage->onEntityChanged(_id);
+            }
+
+            /**
+             * @brief Account for every component of the entity joining or leaving the storage, see
+             * BaseStorage::trackComponent().
+             */
+            void trackComponents(bool alive)
+            {
+                for (type_t type = 0; type < _components.size(); type++) {
+                    if (_components[type]) _storage->trackComponent(type, alive);
+                }
+            }
+
+            std::vector<std::unique_ptr<BaseComponent>> _components;
+            Signature                                   _signature;
+            std::vector<ComponentType>                  _componentsToDelete;
+            Clock                                       _clock;
+            ECS::id_t                                   _id;
+            BaseStorage                                *_storage        = nullptr;
+            Archetype                                  *_archetype      = nullptr;
+            std::size_t                                 _row            = 0;
+            bool                                        _pendingMove    = false;
+            std::atomic<std::size_t>                    _changeTick     = 0;
+            std::atomic<std::size_t>                    _tagsChangeTick = 0;
     };
 
     class GlobalEntity : public Entity
@@ -0,0 +1,187 @@
+/*
+** EPITECH PROJECT, 2024
+** B-CPP-500-LIL-5-2-rtype-ewen.sellitto
+** File description:
+** EntitySet.hpp
+*/
+
+#pragma once
+
+#include <limits>
+#include <vector>
+
+#include "Utilities.hpp"
+
+#ifndef ECS_SPARSE_PAGE_SIZE      // Number of entity ids covered by one page of a sparse index
+#define ECS_SPARSE_PAGE_SIZE 1024 // allocated on first use
+#endif                            // !ECS_SPARSE_PAGE_SIZE
+
+namespace ECS
+{
+    class Entity;
+
+    /**
+     * @class EntitySet
+     * @brief Sparse set of entities.
+     *
+     * @note Entities are packed in a dense array, and a paged sparse array maps the slot index of each entity id (see
+     * Utils::getEntityIndex) to its index in the dense array, so adding, removing and finding an entity are all O(1).
+     * @note Classes storing data next to each entity get notified through a callback whenever a slot is removed, so
+     * they can mirror the move on their own dense array.
+     */
+    class EntitySet
+    {
+        public:
+            EntitySet() : _sparse(), _ids(), _entities() {}
+            ~EntitySet() = default;
+
+            /*================//
+            //  Set Handling  //
+            //================*/
+
+            /**
+             * @brief Check if the entity with the given id is in the set.
+             *
+             * @param id The id of the entity.
+             * @return bool True if the entity is in the set.
+             */
+            bool contains(id_t id) const
+            {
+                std::size_t index = Utils::getEntityIndex(id);
+                std::size_t page  = index / ECS_SPARSE_PAGE_SIZE;
+
+                if (page >= _sparse.size() || _sparse[page].empty()) return false;
+                return _sparse[page][index % ECS_SPARSE_PAGE_SIZE] != npos;
+            }
+
+            /**
+             * @brief Get the dense index of an entity.
+             *
+             * @param id The id of the entity, it must be in the set.
+             * @return std::size_t The index of the entity in the dense arrays.
+             */
+            std::size_t indexOf(id_t id) const
+            {
+                std::size_t index = Utils::getEntityIndex(id);
+
+                return _sparse[index / ECS_SPARSE_PAGE_SIZE][index % ECS_SPARSE_PAGE_SIZE];
+            }
+
+            /**
+             * @brief Append an entity at the end of the set.
+             *
+             * @param id The id of the entity.
+             * @param entity The entity to add.
+             * @return std::size_t The index of the entity in the dense arrays.
+             */
+            std::size_t insert(id_t id, Entity *entity)
+            {
+                std::size_t index = Utils::getEntityIndex(id);
+                std::size_t page  = index / ECS_SPARSE_PAGE_SIZE;
+
+                if (page >= _sparse.size()) _sparse.resize(page + 1);
+                if (_sparse[page].empty()) _sparse[page].assign(ECS_SPARSE_PAGE_SIZE, npos);
+                _sparse[page][index % ECS_SPARSE_PAGE_SIZE] = _entities.size();
+                _ids.push_back(id);
+                _entities.push_back(entity);
+                return _entities.size() - 1;
+            }
+
+            /**
+             * @brief Remove an entity, moving the last entity in its place.
+             *
+             * @param id The id of the entity, it must be in the set.
+             * @param onRemove Called with the removed index and the last index before the last slot is dropped.
+             */
+            template <typename Func> void erase(id_t id, Func &&onRemove)
+            {
+                swapRemove(unlink(id), onRemove);
+            }
+
+            /**
+             * @brief Remove an entity from the index but keep its slot until the next compaction.
+             *
+             * @param id The id of the entity, it must be in the set.
+             * @note Used while iterating, so the dense arrays are not reordered under the iteration.
+             */
+            void tombstone(id_t id)
+            {
+                _entities[unlink(id)] = nullptr;
+                hasHoles              = true;
+            }
+
+            /**
+             * @brief Remove the slots left by tombstone().
+             *
+             * @param onRemove Called with the removed index and the last index before the last slot is dropped.
+             */
+            template <typename Func> void compact(Func &&onRemove)
+            {
+                for (std::size_t index = _entities.size(); index-- > 0;) {
+                    if (_entities[index] == nullptr) swapRemove(index, onRemove);
+                }
+                hasHoles = false;
+            }
+
+            /*===================//
+            //  Getters/Setters  //
+            //===================*/
+
+            std::vector<Entity *> &getEntities()
+            {
+                return _entities;
+            }
+
+            std::vector<id_t> &getIds()
+            {
+                return _ids;
+            }
+
+            std::size_t size() const
+            {
+                return _entities.size();
+            }
+
+            /**
+             * @brief Flag telling that some slots were emptied during an iteration and still have to be compacted.
+             */
+            bool hasHoles = false;
+
+        private:
+            static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+            std::size_t &getSlot(id_t id)
+            {
+                std::size_t index = Utils::getEntityIndex(id);
+
+                return _sparse[index / ECS_SPARSE_PAGE_SIZE][index % ECS_SPARSE_PAGE_SIZE];
+            }
+
+            std::size_t unlink(id_t id)
+            {
+                std::size_t &slot  = getSlot(id);
+                std::size_t  index = slot;
+
+                slot = npos;
+                return index;
+            }
+
+            template <typename Func> void swapRemove(std::size_t index, Func &onRemove)
+            {
+                std::size_t last = _entities.size() - 1;
+
+                if (index != last) {
+                    _ids[index]          = _ids[last];
+                    _entities[index]     = _entities[last];
+                    getSlot(_ids[index]) = index;
+                }
+                onRemove(index, last);
+                _ids.pop_back();
+                _entities.pop_back();
+            }
+
+            std::vector<std::vector<std::size_t>> _sparse;
+            std::vector<id_t>                     _ids;
+            std::vector<Entity *>                 _entities;
+    };
+} // namespace ECS
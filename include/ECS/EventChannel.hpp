@@ -0,0 +1,166 @@
+/*
+** EPITECH PROJECT, 2024
+** B-CPP-500-LIL-5-2-rtype-ewen.sellitto
+** File description:
+** EventChannel.hpp
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "EventSubscriber.hpp"
+#include "Utilities.hpp"
+
+namespace ECS
+{
+    /**
+     * @class BaseEventChannel
+     * @brief Abstract base class of the event channels, lets the World keep the channels of every event type.
+     */
+    class BaseEventChannel
+    {
+        public:
+            virtual ~BaseEventChannel() = default;
+
+            /**
+             * @brief Deliver the queued events to the subscribers.
+             */
+            virtual void flush() = 0;
+    };
+
+    /**
+     * @class EventChannel
+     * @brief Subscribers of one event type, stored contiguously.
+     *
+     * @tparam T The type of the event.
+     * @note Broadcasting walks a vector of typed subscribers: no hash lookup, no cast and no string per call.
+     * @note Subscribers may subscribe and unsubscribe while an event is broadcast, subscribers added during a
+     * broadcast receive the next events only.
+     * @note Events are either broadcast right away, or queued and delivered in one batch by flush(). The queue keeps
+     * its capacity between flushes, so queuing does not allocate once the channel has seen a busy frame.
+     */
+    template <typename T> class EventChannel : public BaseEventChannel
+    {
+        public:
+            EventChannel() : _subscribers(), _queued(), _delivered(), _broadcastDepth(0), _hasHoles(false) {}
+
+            /**
+             * @brief Destroy the channel and the subscribers still subscribed, see World::subscribe().
+             */
+            ~EventChannel() override
+            {
+                for (Entry &entry : _subscribers)
+                    delete entry.subscriber;
+            }
+
+            EventChannel &operator=(const EventChannel &channel) = delete;
+            EventChannel(const EventChannel &channel)            = delete;
+
+            /**
+             * @brief Add a subscriber.
+             *
+             * @param subscriber The subscriber, the channel takes its ownership.
+             * @return id_t The unique identifier of the subscription.
+             */
+            id_t subscribe(EventSubscriber<T> *subscriber)
+            {
+                id_t id = Utils::getNewId<T>();
+
+                _subscribers.push_back({id, subscriber});
+                return id;
+            }
+
+            /**
+             * @brief Remove a subscriber, it is not destroyed.
+             *
+             * @param id The unique identifier of the subscription, ignored if unknown.
+             */
+            void unsubscribe(id_t id)
+            {
+                auto entry = std::find_if(_subscribers.begin(), _subscribers.end(),
+                                          [id](const Entry &subscription) { return subscription.id == id; });
+
+                if (entry == _subscribers.end()) return;
+                if (_broadcastDepth > 0) {
+                    entry->subscriber = nullptr;
+                    _hasHoles         = true;
+                } else {
+                    _subscribers.erase(entry);
+                }
+            }
+
+            /**
+             * @brief Send an event to every subscriber, in subscription order.
+             *
+             * @param data The event.
+             */
+            void broadcast(const T &data)
+            {
+                std::size_t count = _subscribers.size();
+
+                _broadcastDepth++;
+                for (std::size_t i = 0; i < count; i++) {
+                    if (_subscribers[i].subscriber) _subscribers[i].subscriber->receiveEvent(data);
+                }
+                endBroadcast();
+            }
+
+            /**
+             * @brief Keep an event to deliver it with the others at the next flush().
+             *
+             * @param data The event.
+             * @return bool True if it is the first event queued since the last flush.
+             */
+            bool queue(const T &data)
+            {
+                _queued.push_back(data);
+                return _queued.size() == 1;
+            }
+
+            /**
+             * @brief Deliver the queued events, each subscriber gets all of them at once.
+             *
+             * @note Events queued by the subscribers during the flush wait for the next one.
+             */
+            void flush() override
+            {
+                std::size_t count = _subscribers.size();
+
+                _delivered.swap(_queued);
+                _broadcastDepth++;
+                for (std::size_t i = 0; i < count; i++) {
+                    if (_subscribers[i].subscriber) _subscribers[i].subscriber->receiveEvents(_delivered);
+                }
+                endBroadcast();
+                _delivered.clear();
+            }
+
+            bool empty() const
+            {
+                return _subscribers.empty();
+            }
+
+        private:
+            void endBroadcast()
+            {
+                if (--_broadcastDepth == 0 && _hasHoles) {
+                    std::erase_if(_subscribers, [](const Entry &entry) { return entry.subscriber == nullptr; });
+                    _hasHoles = false;
+                }
+            }
+
+            struct Entry {
+                    id_t                id;
+                    EventSubscriber<T> *subscriber;
+            };
+
+            std::vector<Entry> _subscribers;
+            std::vector<T>     _queued;
+            std::vector<T>     _delivered;
+            std::size_t        _broadcastDepth;
+            bool               _hasHoles;
+    };
+} // namespace ECS
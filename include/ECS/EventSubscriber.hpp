@@ -8,6 +8,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include "ECS/Components.hpp"
 #include "ECS/Entity.hpp"
@@ -48,13 +49,37 @@ namespace ECS
             /**
              * @brief Receive and process an event.
              *
-             * @param name The name of the event.
              * @param data A ref to the event data, expected to be of type T.
+             * @note Override this one, the default implementation forwards to the named version for the subscribers
+             * written before the events lost their name.
              *
              * @warning This method can cause infinite recursion if its broadcasting an event of type T or
              * it broadcast an event of type T and another subscriber is also subscribed to that event.
              */
-            virtual void receiveEvent(const std::string &name, const T &data) = 0;
+            virtual void receiveEvent(const T &data)
+            {
+                receiveEvent(std::string(), data);
+            }
+
+            /**
+             * @brief Receive the events queued during a frame, see World::queueEvent().
+             *
+             * @param events The events, in the order they were queued.
+             * @note Override it to process a whole batch at once, the default implementation receives them one by
+             * one.
+             */
+            virtual void receiveEvents(const std::vector<T> &events)
+            {
+                for (const T &data : events)
+                    receiveEvent(data);
+            }
+
+            /**
+             * @brief Receive and process an event, the name is always empty.
+             *
+             * @deprecated Override receiveEvent(const T &) instead.
+             */
+            virtual void receiveEvent(const std::string &, const T &) {}
     };
 
     namespace Events
@@ -0,0 +1,103 @@
+/*
+** EPITECH PROJECT, 2024
+** B-CPP-500-LIL-5-2-rtype-ewen.sellitto
+** File description:
+** MPSCQueue.hpp
+*/
+
+#pragma once
+
+#include <atomic>
+#include <type_traits>
+#include <utility>
+
+namespace ECS
+{
+    /**
+     * @class MPSCQueue
+     * @brief Unbounded lock-free queue, several threads push and a single thread pops.
+     *
+     * @tparam T The type of the elements, default constructible.
+     * @note Hands data from the network thread to the game loop: push() is one atomic exchange and pop() one
+     * atomic load, neither side ever waits for the other.
+     * @note An element pushed while the consumer pops may only show up at its next pop(), elements of a producer are
+     * popped in the order it pushed them.
+     * @warning Only one thread at a time may call pop() and clear().
+     */
+    template <typename T> class MPSCQueue
+    {
+            static_assert(std::is_default_constructible_v<T>, "MPSCQueue elements must be default constructible");
+
+        public:
+            MPSCQueue() : _head(new Node()), _tail(_head.load(std::memory_order_relaxed)) {}
+
+            ~MPSCQueue()
+            {
+                clear();
+                delete _tail;
+            }
+
+            MPSCQueue &operator=(const MPSCQueue &queue) = delete;
+            MPSCQueue(const MPSCQueue &queue)            = delete;
+
+            /**
+             * @brief Add an element at the end of the queue, from any thread.
+             *
+             * @param value The element.
+             */
+            void push(T value)
+            {
+                Node *node     = new Node();
+                Node *previous = nullptr;
+
+                node->value = std::move(value);
+                previous    = _head.exchange(node, std::memory_order_acq_rel);
+                previous->next.store(node, std::memory_order_release);
+            }
+
+            /**
+             * @brief Take the element at the front of the queue, from the consumer thread.
+             *
+             * @param value Filled with the element.
+             * @return bool False if the queue is empty, value is then untouched.
+             */
+            bool pop(T &value)
+            {
+                Node *next = _tail->next.load(std::memory_order_acquire);
+
+                if (!next) return false;
+                value = std::move(next->value);
+                delete _tail;
+                _tail = next;
+                return true;
+            }
+
+            /**
+             * @brief Drop every element, from the consumer thread.
+             */
+            void clear()
+            {
+                T value;
+
+                while (pop(value))
+                    ;
+            }
+
+            /**
+             * @brief Check if the queue is empty, from the consumer thread.
+             */
+            bool empty() const
+            {
+                return _tail->next.load(std::memory_order_acquire) == nullptr;
+            }
+
+        private:
+            struct Node {
+                    std::atomic<Node *> next{nullptr};
+                    T                   value{};
+            };
+
+            alignas(64) std::atomic<Node *> _head; ///< Last pushed node, shared by the producers.
+            alignas(64) Node *_tail;                ///< Node before the front element, owned by the consumer.
+    };
+} // namespace ECS
@@ -0,0 +1,128 @@
+/*
+** EPITECH PROJECT, 2024
+** B-CPP-500-LIL-5-2-rtype-ewen.sellitto
+** File description:
+** MemoryStats.hpp
+*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <ostream>
+
+#include "Utilities.hpp"
+#include "public/ComponentsType.hpp"
+
+namespace ECS
+{
+    /**
+     * @brief Memory used by the components of one type in a World.
+     */
+    struct ComponentMemoryStats {
+            ComponentType componentType = ComponentType::NoneComponent; ///< Network type of the components.
+            std::size_t   size          = 0; ///< Size of one component, in bytes.
+            std::size_t   live          = 0; ///< Number of components alive.
+            std::size_t   bytes         = 0; ///< Memory used by the live components, in bytes.
+            std::size_t   allocations   = 0; ///< Number of components added since the World was created.
+            std::size_t   peak          = 0; ///< Highest number of components alive at once.
+    };
+
+    /**
+     * @class MemoryStats
+     * @brief Snapshot of the memory used by the entities and components of a World, see World::memoryStats().
+     *
+     * @note The components are counted when their entity is in the World. Tags take no memory and are not counted.
+     */
+    class MemoryStats
+    {
+        public:
+            /**
+             * @brief Get the statistics of a component type.
+             *
+             * @tparam T The component type.
+             * @return const ComponentMemoryStats & The statistics, all 0 if the World never had such a component.
+             */
+            template <typename T> const ComponentMemoryStats &get() const
+            {
+                static const ComponentMemoryStats none;
+                type_t                            type = ECS_TYPEID(T);
+
+                return type < ECS_MAX_COMPONENTS ? components[type] : none;
+            }
+
+            /**
+             * @brief Write the statistics in a readable table, one line per component type.
+             *
+             * @param stream The stream to write to, std::cout for example.
+             */
+            void dump(std::ostream &stream) const
+            {
+                stream << "World memory: " << totalBytes << " bytes, " << entities << " entities (" << entityBytes
+                       << " bytes), components " << componentBytes << " bytes\n";
+                for (type_t type = 0; type < ECS_MAX_COMPONENTS; type++) {
+                    const ComponentMemoryStats &stats = components[type];
+
+                    if (stats.allocations == 0) continue;
+                    stream << "  type " << type << " (ComponentType " << static_cast<int>(stats.componentType)
+                           << "): " << stats.live << " live, " << stats.bytes << " bytes, " << stats.allocations
+                           << " allocations, peak " << stats.peak << " (" << stats.size << " bytes each)\n";
+                }
+            }
+
+            /*========================//
+            //  Component Type Sizes  //
+            //========================*/
+
+            /**
+             * @brief Record the size of a component type, done by Entity::addComponent().
+             *
+             * @param type The type identifier of the component.
+             * @param size The size of the component, in bytes.
+             * @param componentType The network type of the component.
+             */
+            static void registerComponent(type_t type, std::size_t size, ComponentType componentType)
+            {
+                getSizes()[type].store(size, std::memory_order_relaxed);
+                getComponentTypes()[type].store(componentType, std::memory_order_relaxed);
+            }
+
+            /**
+             * @brief Get the size of a component type.
+             *
+             * @param type The type identifier of the component.
+             * @return std::size_t The size in bytes, 0 for the tags and the types never added to an entity.
+             */
+            static std::size_t getComponentSize(type_t type)
+            {
+                return getSizes()[type].load(std::memory_order_relaxed);
+            }
+
+            static ComponentType getComponentType(type_t type)
+            {
+                return getComponentTypes()[type].load(std::memory_order_relaxed);
+            }
+
+            std::array<ComponentMemoryStats, ECS_MAX_COMPONENTS> components{};
+            std::size_t                                          entities       = 0;
+            std::size_t                                          entityBytes    = 0;
+            std::size_t                                          componentBytes = 0;
+            std::size_t                                          totalBytes     = 0;
+
+        private:
+            static std::array<std::atomic<std::size_t>, ECS_MAX_COMPONENTS> &getSizes()
+            {
+                static std::array<std::atomic<std::size_t>, ECS_MAX_COMPONENTS> sizes{};
+
+                return sizes;
+            }
+
+            static std::array<std::atomic<ComponentType>, ECS_MAX_COMPONENTS> &getComponentTypes()
+            {
+                static std::array<std::atomic<ComponentType>, ECS_MAX_COMPONENTS> componentTypes{};
+
+                return componentTypes;
+            }
+    };
+} // namespace ECS
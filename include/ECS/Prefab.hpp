@@ -0,0 +1,108 @@
+/*
+** EPITECH PROJECT, 2024
+** B-CPP-500-LIL-5-2-rtype-ewen.sellitto
+** File description:
+** Prefab.hpp
+*/
+
+#pragma once
+
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "Components.hpp"
+#include "Entity.hpp"
+
+namespace ECS
+{
+    /**
+     * @class Prefab
+     * @brief Template of an entity: a set of components copied onto every entity spawned from it.
+     *
+     * @note The components of the template are built once, so costly setup (loading a texture, parsing data...) is
+     * not repeated for every spawned entity. Register prefabs with World::registerPrefab() and instantiate them with
+     * World::spawn().
+     * @warning Component types of a prefab must be copy constructible, and their copies must not share mutable state
+     * with the template.
+     */
+    class Prefab
+    {
+        public:
+            Prefab() : _components() {}
+            ~Prefab() = default;
+
+            Prefab(Prefab &&prefab)            = default;
+            Prefab &operator=(Prefab &&prefab) = default;
+
+            /**
+             * @brief Add a component to the template.
+             *
+             * @tparam T Type of the component.
+             * @param component The component, created with 'new', the prefab takes its ownership.
+             * @return Prefab & The prefab, to chain the calls.
+             * @note A second component of the same type replaces the first one.
+             */
+            template <typename T> Prefab &addComponent(T *component)
+            {
+                static_assert(std::is_copy_constructible_v<T>, "Prefab components must be copy constructible");
+
+                for (Entry &entry : _components) {
+                    if (entry.type == ECS_TYPEID(T)) {
+                        entry.component.reset(component);
+                        return *this;
+                    }
+                }
+                _components.push_back(
+                    {ECS_TYPEID(T), sizeof(T), std::unique_ptr<BaseComponent>(component), &copyComponent<T>});
+                return *this;
+            }
+
+            /**
+             * @brief Create an entity holding a copy of every component of the template.
+             *
+             * @return std::unique_ptr<Entity> The entity, not yet added to a World.
+             * @note The components are added before the entity joins a World, so the storage files it once, directly
+             * in its final archetype.
+             */
+            std::unique_ptr<Entity> instantiate() const
+            {
+                std::unique_ptr<Entity> entity = std::make_unique<Entity>();
+
+                for (const Entry &entry : _components)
+                    entry.copy(*entity, *entry.component);
+                return entity;
+            }
+
+            /**
+             * @brief Make sure the component pools can serve a number of instantiations without growing.
+             *
+             * @param count The number of entities about to be instantiated.
+             */
+            void reserveComponents(std::size_t count) const
+            {
+                for (const Entry &entry : _components)
+                    ComponentAllocator::reserve(entry.size, count);
+            }
+
+            std::size_t size() const
+            {
+                return _components.size();
+            }
+
+        private:
+            struct Entry {
+                    type_t                         type;
+                    std::size_t                    size;
+                    std::unique_ptr<BaseComponent> component;
+                    void (*copy)(Entity &, const BaseComponent &);
+            };
+
+            template <typename T> static void copyComponent(Entity &entity, const BaseComponent &component)
+            {
+                entity.addComponent(new T(static_cast<const T &>(component)));
+            }
+
+            std::vector<Entry> _components;
+    };
+} // namespace ECS
@@ -0,0 +1,280 @@
+/*
+** EPITECH PROJECT, 2024
+** B-CPP-500-LIL-5-2-rtype-ewen.sellitto
+** File description:
+** Query.hpp
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Archetype.hpp"
+#include "BaseQuery.hpp"
+#include "Components.hpp"
+#include "Entity.hpp"
+#include "SparseSet.hpp"
+#include "Storage.hpp"
+#include "ThreadPool.hpp"
+#include "Utilities.hpp"
+
+#ifndef ECS_PARALLEL_CHUNK_SIZE     // Number of entities handed to a thread at once by Query::parallelEach
+#define ECS_PARALLEL_CHUNK_SIZE 256 // (each chunk covers the rows of a single table)
+#endif                              // !ECS_PARALLEL_CHUNK_SIZE
+
+namespace ECS
+{
+    /**
+     * @class Query
+     * @brief Persistent view on every entity owning a given set of components.
+     *
+     * @tparam Types The component types required by the query.
+     * @note Queries are created once by World::query() and kept up to date by the storage backend, so iterating one
+     * only costs the number of matching entities (archetype storage: matching tables and their column indexes are
+     * cached; sparse set storage: the matching entities themselves are cached).
+     */
+    template <typename... Types> class Query : public BaseQuery
+    {
+        public:
+            /**
+             * @brief Construct a new Query object.
+             *
+             * @param storage The storage backend the query reads from.
+             * @param storageType The type of the storage backend.
+             * @warning Meant to be called by the World only, the query must then be registered with addQuery().
+             */
+            Query(BaseStorage &storage, StorageType storageType)
+                : BaseQuery(Utils::getSignature<Types...>()), _storage(storage), _storageType(storageType), _tables(),
+                  _pools(), _chunks()
+            {
+                if (storageType == StorageType::SparseSet)
+                    _pools = {&static_cast<SparseSetStorage &>(storage).getPool(ECS_TYPEID(Types))...};
+            }
+
+            ~Query() override = default;
+
+            void onArchetypeCreated(Archetype *archetype) override
+            {
+                if (matches(archetype->getSignature()))
+                    _tables.push_back({archetype, {archetype->getColumnIndex(ECS_TYPEID(Types))...}});
+            }
+
+            /*=============//
+            //  Iteration  //
+            //=============*/
+
+            /**
+             * @brief Call a function on every entity matching the query.
+             *
+             * @param func The function called with the entity then either a ComponentHandle<T> for every component
+             * type T or a T & for every one of them (chosen at compile time from the signature of the function).
+             * @note Entities created during the iteration are not visited.
+             * @note Tags (see Tag) can be part of the types, their parameter is a shared empty instance.
+             */
+            template <typename Func> void each(Func &&func)
+            {
+                BaseStorage::IterationLock lock(_storage);
+
+                if (_storageType == StorageType::SparseSet)
+                    eachMember(func);
+                else
+                    eachTable(func);
+            }
+
+            /**
+             * @brief Call a function on every entity matching the query, spreading the entities over a thread pool.
+             *
+             * @param func The function called with the entity and its components, like each().
+             * @param pool The thread pool running the chunks of entities.
+             * @warning The function runs on several threads at once. It may write the components it is given and read
+             * any component no call writes, but it must not add or remove components or entities, broadcast events or
+             * touch the components of another entity: structural changes and events are not thread safe.
+             * @note Returns once every entity was visited, the order of the visits is unspecified.
+             * @note Called from a job of a pool (a system of a parallel stage, see World::tick()), the entities are
+             * visited by each() on the calling thread.
+             */
+            template <typename Func> void parallelEach(Func &&func, ThreadPool &pool)
+            {
+                if (ThreadPool::isInJob()) return each(std::forward<Func>(func));
+
+                BaseStorage::IterationLock lock(_storage);
+
+                _chunks.clear();
+                if (_storageType == StorageType::SparseSet) {
+                    addChunks(nullptr, _members.size());
+                } else {
+                    for (const Table &table : _tables)
+                        addChunks(&table, table.archetype->size());
+                }
+                pool.run(_chunks.size(), [&](std::size_t index) {
+                    if (_storageType == StorageType::SparseSet)
+                        eachMember(func, _chunks[index], std::index_sequence_for<Types...>{});
+                    else
+                        eachTable(func, _chunks[index], std::index_sequence_for<Types...>{});
+                });
+            }
+
+            /**
+             * @brief Append every entity matching the query to a vector.
+             *
+             * @param entities The vector to fill.
+             */
+            void collect(std::vector<Entity *> &entities)
+            {
+                if (_storageType == StorageType::SparseSet) {
+                    for (Entity *entity : _members.getEntities()) {
+                        if (entity != nullptr) entities.push_back(entity);
+                    }
+                    return;
+                }
+                for (const Table &table : _tables) {
+                    for (Entity *entity : table.archetype->getEntities()) {
+                        if (isVisible(entity)) entities.push_back(entity);
+                    }
+                }
+            }
+
+            /**
+             * @brief Get the first entity matching the query.
+             *
+             * @return Entity * The first matching entity, nullptr if there is none.
+             */
+            Entity *first()
+            {
+                if (_storageType == StorageType::SparseSet) {
+                    for (Entity *entity : _members.getEntities()) {
+                        if (entity != nullptr) return entity;
+                    }
+                    return nullptr;
+                }
+                for (const Table &table : _tables) {
+                    for (Entity *entity : table.archetype->getEntities()) {
+                        if (isVisible(entity)) return entity;
+                    }
+                }
+                return nullptr;
+            }
+
+        private:
+            /**
+             * @brief An archetype matching the query, with the column of each requested type.
+             */
+            struct Table {
+                    Archetype                                *archetype;
+                    std::array<std::size_t, sizeof...(Types)> columns;
+            };
+
+            /**
+             * @brief A range of rows of a matching table (or of the matching entities in sparse set mode).
+             */
+            struct Chunk {
+                    const Table *table;
+                    std::size_t  begin;
+                    std::size_t  end;
+            };
+
+            /**
+             * @brief Check if an entity of a matching table must be visited.
+             *
+             * @note Rows emptied during an iteration are null, and entities that changed during an iteration are still
+             * in their old table until the iteration ends.
+             */
+            static bool isVisible(Entity *entity)
+            {
+                if (entity == nullptr) return false;
+                return !entity->_pendingMove || entity->template has<Types...>();
+            }
+
+            /**
+             * @brief Call the function of each() on an entity, with handles or references depending on what it takes.
+             */
+            template <typename Func> static void call(Func &func, Entity *entity, Types *...components)
+            {
+                if constexpr (std::is_invocable_v<Func &, Entity *, ComponentHandle<Types>...>)
+                    func(entity, ComponentHandle<Types>(components)...);
+                else
+                    func(entity, *components...);
+            }
+
+            /**
+             * @brief Get a component of a row of a table, tags (empty types) get a shared instance of their type.
+             */
+            template <typename T> static T *getTableComponent(Archetype *archetype, std::size_t column, std::size_t row)
+            {
+                if constexpr (std::is_empty_v<T>)
+                    return &getTag<T>();
+                else
+                    return static_cast<T *>(archetype->getColumn(column)[row]);
+            }
+
+            template <typename T> static T *getPoolComponent(ComponentPool *pool, id_t id)
+            {
+                if constexpr (std::is_empty_v<T>)
+                    return &getTag<T>();
+                else
+                    return static_cast<T *>(pool->get(id));
+            }
+
+            template <typename T> static T &getTag()
+            {
+                static T tag;
+
+                return tag;
+            }
+
+            template <typename Func> void eachTable(Func &func)
+            {
+                std::size_t tablesCount = _tables.size();
+
+                for (std::size_t i = 0; i < tablesCount; i++) {
+                    Table table = _tables[i];
+                    eachTable(func, {&table, 0, table.archetype->size()}, std::index_sequence_for<Types...>{});
+                }
+            }
+
+            template <typename Func, std::size_t... Indexes>
+            void eachTable(Func &func, const Chunk &chunk, std::index_sequence<Indexes...>)
+            {
+                Archetype  *archetype = chunk.table->archetype;
+                const auto &columns   = chunk.table->columns;
+
+                for (std::size_t row = chunk.begin; row < chunk.end; row++) {
+                    Entity *entity = archetype->getEntities()[row];
+                    if (!isVisible(entity)) continue;
+                    call(func, entity, getTableComponent<Types>(archetype, columns[Indexes], row)...);
+                }
+            }
+
+            template <typename Func> void eachMember(Func &func)
+            {
+                eachMember(func, {nullptr, 0, _members.size()}, std::index_sequence_for<Types...>{});
+            }
+
+            template <typename Func, std::size_t... Indexes>
+            void eachMember(Func &func, const Chunk &chunk, std::index_sequence<Indexes...>)
+            {
+                for (std::size_t i = chunk.begin; i < chunk.end; i++) {
+                    Entity *entity = _members.getEntities()[i];
+                    id_t    id     = _members.getIds()[i];
+                    if (entity == nullptr) continue;
+                    call(func, entity, getPoolComponent<Types>(_pools[Indexes], id)...);
+                }
+            }
+
+            void addChunks(const Table *table, std::size_t rows)
+            {
+                for (std::size_t begin = 0; begin < rows; begin += ECS_PARALLEL_CHUNK_SIZE)
+                    _chunks.push_back({table, begin, std::min(begin + ECS_PARALLEL_CHUNK_SIZE, rows)});
+            }
+
+            BaseStorage                                  &_storage;
+            StorageType                                   _storageType;
+            std::vector<Table>                            _tables;
+            std::array<ComponentPool *, sizeof...(Types)> _pools;
+            std::vector<Chunk>                            _chunks;
+    };
+} // namespace ECS
@@ -0,0 +1,149 @@
+/*
+** EPITECH PROJECT, 2024
+** B-CPP-500-LIL-5-2-rtype-ewen.sellitto
+** File description:
+** SoABuffer.hpp
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#ifndef ECS_SOA_CHUNK_SIZE     // Number of elements per chunk of a SoABuffer, keep it a multiple of the widest
+#define ECS_SOA_CHUNK_SIZE 256 // SIMD register (16 floats for AVX-512)
+#endif                         // !ECS_SOA_CHUNK_SIZE
+
+namespace ECS
+{
+    /**
+     * @class SoABuffer
+     * @brief Structure of arrays of plain data, split in fixed size chunks.
+     *
+     * @tparam Fields The type of each field, one array per field.
+     * @note Each chunk holds one aligned array per field, so a loop over a field of a chunk reads contiguous memory
+     * the compiler can vectorize (SSE/AVX) without any intrinsic. Growing the buffer adds chunks and never moves the
+     * existing ones, and clear() keeps them for the next fill.
+     * @note Meant for the hot loops of the systems: gather the plain data of the matching components once, run the
+     * computation field by field on whole chunks, then write the results back.
+     */
+    template <typename... Fields> class SoABuffer
+    {
+            static_assert((std::is_trivially_copyable_v<Fields> && ...), "SoABuffer fields must be plain data");
+
+        public:
+            SoABuffer() : _chunks(), _size(0) {}
+            ~SoABuffer() = default;
+
+            SoABuffer &operator=(const SoABuffer &buffer) = delete;
+            SoABuffer(const SoABuffer &buffer)            = delete;
+
+            /*===================//
+            //  Buffer Handling  //
+            //===================*/
+
+            /**
+             * @brief Append an element at the end of the buffer.
+             *
+             * @param values The value of each field of the element.
+             * @return std::size_t The index of the element.
+             */
+            std::size_t push(Fields... values)
+            {
+                std::size_t index = _size;
+
+                if (index / ECS_SOA_CHUNK_SIZE >= _chunks.size()) _chunks.push_back(std::make_unique<Chunk>());
+                pushTo(*_chunks[index / ECS_SOA_CHUNK_SIZE], index % ECS_SOA_CHUNK_SIZE,
+                       std::index_sequence_for<Fields...>(), values...);
+                _size++;
+                return index;
+            }
+
+            /**
+             * @brief Remove every element, the chunks are kept for the next elements.
+             */
+            void clear()
+            {
+                _size = 0;
+            }
+
+            /**
+             * @brief Get a field of an element.
+             *
+             * @tparam Field The index of the field in Fields.
+             * @param index The index of the element.
+             * @return The field, by reference.
+             */
+            template <std::size_t Field> auto &get(std::size_t index)
+            {
+                return std::get<Field>(_chunks[index / ECS_SOA_CHUNK_SIZE]->columns).values[index % ECS_SOA_CHUNK_SIZE];
+            }
+
+            /*================//
+            //  Chunk Access  //
+            //================*/
+
+            /**
+             * @brief Get the array of a field in a chunk.
+             *
+             * @tparam Field The index of the field in Fields.
+             * @param chunk The index of the chunk.
+             * @return A pointer to the first element of the array, aligned on a cache line.
+             */
+            template <std::size_t Field> auto *column(std::size_t chunk)
+            {
+                return std::get<Field>(_chunks[chunk]->columns).values;
+            }
+
+            /**
+             * @brief Get the number of chunks holding elements.
+             */
+            std::size_t chunkCount() const
+            {
+                return (_size + ECS_SOA_CHUNK_SIZE - 1) / ECS_SOA_CHUNK_SIZE;
+            }
+
+            /**
+             * @brief Get the number of elements of a chunk.
+             *
+             * @param chunk The index of the chunk, lower than chunkCount().
+             * @return std::size_t ECS_SOA_CHUNK_SIZE, except for the last chunk.
+             */
+            std::size_t chunkSize(std::size_t chunk) const
+            {
+                return std::min<std::size_t>(_size - chunk * ECS_SOA_CHUNK_SIZE, ECS_SOA_CHUNK_SIZE);
+            }
+
+            std::size_t size() const
+            {
+                return _size;
+            }
+
+            bool empty() const
+            {
+                return _size == 0;
+            }
+
+        private:
+            template <typename Field> struct alignas(64) Column {
+                    Field values[ECS_SOA_CHUNK_SIZE];
+            };
+
+            struct Chunk {
+                    std::tuple<Column<Fields>...> columns;
+            };
+
+            template <std::size_t... Indexes>
+            static void pushTo(Chunk &chunk, std::size_t row, std::index_sequence<Indexes...>, Fields... values)
+            {
+                ((std::get<Indexes>(chunk.columns).values[row] = values), ...);
+            }
+
+            std::vector<std::unique_ptr<Chunk>> _chunks;
+            std::size_t                         _size;
+    };
+} // namespace ECS
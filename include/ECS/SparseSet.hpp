@@ -0,0 +1,219 @@
+/*
+** EPITECH PROJECT, 2024
+** B-CPP-500-LIL-5-2-rtype-ewen.sellitto
+** File description:
+** SparseSet.hpp
+*/
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "BaseQuery.hpp"
+#include "Components.hpp"
+#include "Entity.hpp"
+#include "EntitySet.hpp"
+#include "Storage.hpp"
+#include "Utilities.hpp"
+
+namespace ECS
+{
+    /**
+     * @class ComponentPool
+     * @brief Sparse set storing every component of a single type.
+     *
+     * @note The components are kept in a dense array aligned with the entities of the set, so adding, removing and
+     * finding a component are all O(1). The pool of a tag only keeps the entities, its components are null.
+     */
+    class ComponentPool : public EntitySet
+    {
+        public:
+            ComponentPool() : EntitySet(), _components() {}
+            ~ComponentPool() = default;
+
+            /*================//
+            //  Set Handling  //
+            //================*/
+
+            /**
+             * @brief Get the component of an entity.
+             *
+             * @param id The id of the entity, it must be in the pool.
+             * @return BaseComponent * The component of the entity.
+             */
+            BaseComponent *get(id_t id) const
+            {
+                return _components[indexOf(id)];
+            }
+
+            /**
+             * @brief Append the component of an entity to the pool.
+             *
+             * @param id The id of the entity.
+             * @param entity The entity owning the component.
+             * @param component The component to store, owned by the entity.
+             */
+            void insert(id_t id, Entity *entity, BaseComponent *component)
+            {
+                EntitySet::insert(id, entity);
+                _components.push_back(component);
+            }
+
+            /**
+             * @brief Remove the component of an entity, moving the last component in its place.
+             *
+             * @param id The id of the entity, it must be in the pool.
+             */
+            void erase(id_t id)
+            {
+                EntitySet::erase(id, [this](std::size_t index, std::size_t last) { removeComponent(index, last); });
+            }
+
+            /**
+             * @brief Remove the slots left by tombstone().
+             */
+            void compact()
+            {
+                EntitySet::compact([this](std::size_t index, std::size_t last) { removeComponent(index, last); });
+            }
+
+        private:
+            void removeComponent(std::size_t index, std::size_t last)
+            {
+                if (index != last) _components[index] = _components[last];
+                _components.pop_back();
+            }
+
+            std::vector<BaseComponent *> _components;
+    };
+
+    /**
+     * @class SparseSetStorage
+     * @brief Storage backend keeping one sparse set per component type.
+     *
+     * @note Adding or removing a component only touches the pool of its type and the queries requiring it, which
+     * suits components that are constantly added and removed (e.g. MovingComponent). Each query keeps its own set of
+     * matching entities, so iterating it never probes the pools of entities that do not match.
+     * @warning Components removed while an iteration is running leave an empty slot in their pool until the outermost
+     * iteration ends, so an entity is never visited twice by the same iteration.
+     */
+    class SparseSetStorage : public BaseStorage
+    {
+        public:
+            SparseSetStorage() : _pools(), _queries(), _queriesByType() {}
+            ~SparseSetStorage() override = default;
+
+            /*===================//
+            //  Entity Tracking  //
+            //===================*/
+
+            void insert(Entity *entity) override
+            {
+                const Signature &signature = entity->getSignature();
+
+                entity->_storage = this;
+                for (type_t type = 0; type < signature.size(); type++) {
+                    if (signature.test(type)) getPool(type).insert(entity->getId(), entity, getComponent(entity, type));
+                }
+                for (type_t type = 0; type < signature.size(); type++) {
+                    if (!signature.test(type)) continue;
+                    for (BaseQuery *query : getQueries(type))
+                        query->update(entity, isLocked());
+                }
+            }
+
+            void erase(Entity *entity) override
+            {
+                const Signature &signature = entity->getSignature();
+
+                for (type_t type = 0; type < signature.size(); type++) {
+                    if (signature.test(type)) onComponentRemoved(entity, type);
+                }
+            }
+
+            void onComponentAdded(Entity *entity, type_t type) override
+            {
+                getPool(type).insert(entity->getId(), entity, getComponent(entity, type));
+                for (BaseQuery *query : getQueries(type))
+                    query->update(entity, isLocked());
+            }
+
+            void onComponentRemoved(Entity *entity, type_t type) override
+            {
+                ComponentPool &pool = getPool(type);
+
+                if (!pool.contains(entity->getId())) return;
+                if (isLocked())
+                    pool.tombstone(entity->getId());
+                else
+                    pool.erase(entity->getId());
+                for (BaseQuery *query : getQueries(type))
+                    query->remove(entity, isLocked());
+            }
+
+            void addQuery(BaseQuery *query) override
+            {
+                ComponentPool *smallest = nullptr;
+
+                _queries.push_back(query);
+                for (type_t type = 0; type < query->getSignature().size(); type++) {
+                    if (!query->getSignature().test(type)) continue;
+                    ComponentPool &pool = getPool(type);
+                    getQueries(type).push_back(query);
+                    if (smallest == nullptr || pool.size() < smallest->size()) smallest = &pool;
+                }
+                if (smallest == nullptr) return;
+                for (Entity *entity : smallest->getEntities()) {
+                    if (entity != nullptr) query->update(entity, false);
+                }
+            }
+
+            /*===================//
+            //  Getters/Setters  //
+            //===================*/
+
+            /**
+             * @brief Get the pool of a component type, creating it if needed.
+             *
+             * @param type The type identifier of the component.
+             * @return ComponentPool & The pool storing every component of this type.
+             */
+            ComponentPool &getPool(type_t type)
+            {
+                if (type >= _pools.size()) _pools.resize(type + 1);
+                if (!_pools[type]) _pools[type] = std::make_unique<ComponentPool>();
+                return *_pools[type];
+            }
+
+        private:
+            /**
+             * @brief Get the component of a type of an entity, nullptr for the tags.
+             */
+            static BaseComponent *getComponent(Entity *entity, type_t type)
+            {
+                auto &components = entity->getComponents();
+
+                return type < components.size() ? components[type].get() : nullptr;
+            }
+
+            std::vector<BaseQuery *> &getQueries(type_t type)
+            {
+                if (type >= _queriesByType.size()) _queriesByType.resize(type + 1);
+                return _queriesByType[type];
+            }
+
+            void flush() override
+            {
+                for (auto &pool : _pools) {
+                    if (pool && pool->hasHoles) pool->compact();
+                }
+                for (BaseQuery *query : _queries)
+                    query->compact();
+            }
+
+            std::vector<std::unique_ptr<ComponentPool>> _pools;
+            std::vector<BaseQuery *>                    _queries;
+            std::vector<std::vector<BaseQuery *>>       _queriesByType;
+    };
+} // namespace ECS
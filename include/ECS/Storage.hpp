@@ -0,0 +1,255 @@
+/*
+** EPITECH PROJECT, 2024
+** B-CPP-500-LIL-5-2-rtype-ewen.sellitto
+** File description:
+** Storage.hpp
+*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include "MemoryStats.hpp"
+#include "Utilities.hpp"
+
+namespace ECS
+{
+    class BaseQuery;
+    class Entity;
+
+    /**
+     * @brief Component storage backends a World can be created with.
+     */
+    enum class StorageType {
+        Archetype, ///< Entities grouped in tables by component signature, fastest iteration.
+        SparseSet, ///< One pool per component type, fastest component addition and removal.
+    };
+
+    /**
+     * @class BaseStorage
+     * @brief Abstract base class for the component storage backends of a World.
+     *
+     * @note Entities keep a pointer to the storage of their World and notify it whenever their set of components
+     * changes, so the storage can keep its indexes up to date.
+     */
+    class BaseStorage
+    {
+        public:
+            /**
+             * @brief Virtual destructor for BaseStorage.
+             */
+            virtual ~BaseStorage() = default;
+
+            /**
+             * @brief Start tracking an entity and the components it already owns.
+             *
+             * @param entity The entity to track.
+             */
+            virtual void insert(Entity *entity) = 0;
+
+            /**
+             * @brief Stop tracking an entity.
+             *
+             * @param entity The entity to forget.
+             * @note Called by the entity destructor, the entity is still fully alive.
+             */
+            virtual void erase(Entity *entity) = 0;
+
+            /**
+             * @brief Notify the storage that a component was added to a tracked entity.
+             *
+             * @param entity The entity that changed.
+             * @param type The type identifier of the added component.
+             */
+            virtual void onComponentAdded(Entity *entity, type_t type) = 0;
+
+            /**
+             * @brief Notify the storage that a component was removed from a tracked entity.
+             *
+             * @param entity The entity that changed.
+             * @param type The type identifier of the removed component.
+             */
+            virtual void onComponentRemoved(Entity *entity, type_t type) = 0;
+
+            /**
+             * @brief Register a query the storage must keep up to date.
+             *
+             * @param query The query, owned by the World and alive as long as the storage.
+             * @note The query is filled with the entities already tracked by the storage.
+             */
+            virtual void addQuery(BaseQuery *query) = 0;
+
+            /*================//
+            //  Change Ticks  //
+            //================*/
+
+            /**
+             * @brief Get the tick the components written now are stamped with.
+             *
+             * @return std::size_t The current change tick, starting at 1.
+             */
+            std::size_t getChangeTick() const
+            {
+                return _changeTick;
+            }
+
+            /**
+             * @brief Start a new change tick, so a consumer can later tell the writes made after this call.
+             *
+             * @return std::size_t The tick that just ended, a component changed after this call if its change tick is
+             * greater than it.
+             * @note Each consumer keeps the tick returned by its last call, see BaseComponent::hasChangedSince().
+             */
+            std::size_t markChangeTick()
+            {
+                return _changeTick++;
+            }
+
+            /**
+             * @brief Stamp the current tick on a component type.
+             *
+             * @param type The type identifier of the written component.
+             * @note Safe to call from the threads of a parallel iteration.
+             */
+            void onComponentChanged(type_t type)
+            {
+                _typeChangeTicks[type].store(_changeTick, std::memory_order_relaxed);
+            }
+
+            /**
+             * @brief Get the last tick a component of a type was written.
+             *
+             * @param type The type identifier of the component.
+             * @return std::size_t The tick, 0 if no component of this type was ever written.
+             * @note Lets a consumer skip a whole component type when nothing of this type changed since its last run.
+             */
+            std::size_t getTypeChangeTick(type_t type) const
+            {
+                if (type >= ECS_MAX_COMPONENTS) return 0;
+                return _typeChangeTicks[type].load(std::memory_order_relaxed);
+            }
+
+            /**
+             * @brief Entry of the change log: an entity got a component written during a change tick.
+             */
+            struct Change {
+                    id_t        entity;
+                    std::size_t tick;
+            };
+
+            /**
+             * @brief Log that an entity got a component written during the current change tick.
+             *
+             * @param entity The id of the entity, logged once per change tick by the entity itself.
+             * @note Safe to call from the threads of a parallel iteration.
+             */
+            void onEntityChanged(id_t entity)
+            {
+                std::lock_guard<std::mutex> lock(_changesMutex);
+
+                _changes.push_back({entity, _changeTick});
+            }
+
+            /**
+             * @brief Get the change log.
+             *
+             * @return std::vector<Change> & The changed entities sorted by change tick, an entity may appear once per
+             * tick and destroyed entities are only dropped by World::tick(). Use World::eachChangedEntity().
+             */
+            std::vector<Change> &getChanges()
+            {
+                return _changes;
+            }
+
+            /*=====================//
+            //  Memory Accounting  //
+            //=====================*/
+
+            /**
+             * @brief Account for a component joining or leaving the storage.
+             *
+             * @param type The type identifier of the component, tags are ignored.
+             * @param alive True when the component joins the storage, false when it leaves it.
+             * @note Called by the entities, see World::memoryStats().
+             */
+            void trackComponent(type_t type, bool alive)
+            {
+                std::size_t           size  = MemoryStats::getComponentSize(type);
+                ComponentMemoryStats &stats = _memoryStats[type];
+
+                if (size == 0) return;
+                if (alive) {
+                    stats.live++;
+                    stats.allocations++;
+                    if (stats.live > stats.peak) stats.peak = stats.live;
+                } else if (stats.live > 0) {
+                    stats.live--;
+                }
+                stats.size  = size;
+                stats.bytes = stats.live * size;
+            }
+
+            /**
+             * @brief Get the statistics of every component type, indexed by type identifier.
+             */
+            const std::array<ComponentMemoryStats, ECS_MAX_COMPONENTS> &getMemoryStats() const
+            {
+                return _memoryStats;
+            }
+
+            /**
+             * @class IterationLock
+             * @brief Scope guard deferring the storage updates while an iteration is running.
+             *
+             * @note The systems of a parallel stage iterate at once, World::tick() then holds the outermost lock.
+             */
+            class IterationLock
+            {
+                public:
+                    explicit IterationLock(BaseStorage &storage) : _storage(storage)
+                    {
+                        _storage._lockDepth++;
+                    }
+
+                    ~IterationLock()
+                    {
+                        if (_storage._lockDepth.fetch_sub(1) == 1) _storage.flush();
+                    }
+
+                    IterationLock(const IterationLock &)            = delete;
+                    IterationLock &operator=(const IterationLock &) = delete;
+
+                private:
+                    BaseStorage &_storage;
+            };
+
+        protected:
+            /**
+             * @brief Check if an iteration is running on the storage.
+             *
+             * @return bool True if structural changes must be deferred.
+             */
+            bool isLocked() const
+            {
+                return _lockDepth > 0;
+            }
+
+            /**
+             * @brief Apply the changes deferred during an iteration.
+             *
+             * @note Called when the outermost iteration ends.
+             */
+            virtual void flush() = 0;
+
+        private:
+            std::atomic<std::size_t>                                 _lockDepth  = 0;
+            std::size_t                                              _changeTick = 1;
+            std::array<std::atomic<std::size_t>, ECS_MAX_COMPONENTS> _typeChangeTicks{};
+            std::vector<Change>                                      _changes;
+            std::mutex                                               _changesMutex;
+            std::array<ComponentMemoryStats, ECS_MAX_COMPONENTS>     _memoryStats{};
+    };
+} // namespace ECS
@@ -22,6 +22,8 @@ namespace ECS
      *
      * @note This class provides the interface and common functionality for systems,
      * which are responsible for processing entities that have a specific set of components.
+     * @note A system declaring the components it reads and writes (see reads() and writes()) can run at the same
+     * time as the systems it does not conflict with, see World::tick(). A system declaring nothing runs alone.
      */
     class BaseSystem
     {
@@ -31,7 +33,8 @@ namespace ECS
              *
              * @param world Reference to the World object that this system is part of.
              */
-            explicit BaseSystem(World &world) : _world(world), _entities_id(), _clock(){};
+            explicit BaseSystem(World &world)
+                : _world(world), _entities_id(), _clock(), _reads(), _writes(), _declared(false), _last(false){};
 
             /**
              * @brief Construct a new BaseSystem object and initialize it with a list of entity IDs.
@@ -39,7 +42,8 @@ namespace ECS
              * @param world Reference to the World object that this system is part of.
              * @param ids A variable number of entity IDs to be processed by this system.
              */
-            BaseSystem(World &world, id_t ids...) : _world(world), _entities_id()
+            BaseSystem(World &world, id_t ids...)
+                : _world(world), _entities_id(), _reads(), _writes(), _declared(false), _last(false)
             {
                 _entities_id.emplace_back(ids);
             }
@@ -84,10 +88,88 @@ namespace ECS
                 return _world;
             }
 
+            /*====================//
+            //  Component Access  //
+            //====================*/
+
+            /**
+             * @brief Check if two systems may not run at the same time.
+             *
+             * @param system The other system.
+             * @return bool True if one of them declared nothing, or writes a component the other reads or writes.
+             */
+            bool conflictsWith(const BaseSystem &system) const
+            {
+                if (!_declared || !system._declared) return true;
+                return (_writes & (system._reads | system._writes)).any() || (system._writes & _reads).any();
+            }
+
+            const Signature &getReads() const
+            {
+                return _reads;
+            }
+
+            const Signature &getWrites() const
+            {
+                return _writes;
+            }
+
+            /**
+             * @brief Check if the system runs once per tick after every other system, see runsLast().
+             */
+            bool isLast() const
+            {
+                return _last;
+            }
+
+        protected:
+            /**
+             * @brief Declare components the system reads, call it from the constructor.
+             *
+             * @tparam Types The component or tag types.
+             * @warning Once its access is declared, the system may run on a worker thread at the same time as other
+             * systems: it must only touch the declared components, record structural changes with World::commands()
+             * and must not broadcast or queue events, like the callable of World::parallelEach().
+             * @note The world puts the system in the stage after the last conflicting system added before it (see
+             * conflictsWith()), so it shares its stage with the systems not writing what it reads and not using what
+             * it writes.
+             */
+            template <typename... Types> void reads()
+            {
+                _reads |= Utils::getSignature<Types...>();
+                _declared = true;
+            }
+
+            /**
+             * @brief Declare components the system writes, call it from the constructor.
+             *
+             * @tparam Types The component or tag types.
+             * @warning Same rules as reads().
+             */
+            template <typename... Types> void writes()
+            {
+                _writes |= Utils::getSignature<Types...>();
+                _declared = true;
+            }
+
+            /**
+             * @brief Run the system once per tick, after every other system and on the game loop thread.
+             *
+             * @note Meant for the systems drawing the frame, the Renderer calls it.
+             */
+            void runsLast()
+            {
+                _last = true;
+            }
+
         private:
             [[maybe_unused]] World &_world;       ///< Reference to the World this system belongs to.
             std::vector<id_t>       _entities_id; ///< List of entity IDs that this system processes.
             [[maybe_unused]] Clock  _clock{};     ///< Clock used to track the time between ticks.
+            Signature               _reads;       ///< Components read by the system.
+            Signature               _writes;      ///< Components written by the system.
+            bool                    _declared;    ///< True once the system declared its components.
+            bool                    _last;        ///< True if the system runs after every other system.
     };
 
     class HigherOrderBaseSystem : public BaseSystem
@@ -0,0 +1,221 @@
+/*
+** EPITECH PROJECT, 2024
+** B-CPP-500-LIL-5-2-rtype-ewen.sellitto
+** File description:
+** ThreadPool.hpp
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifndef ECS_THREAD_COUNT   // Number of worker threads of the thread pool, 0 uses one thread per hardware core
+#define ECS_THREAD_COUNT 0 // (the calling thread always works too)
+#endif                     // !ECS_THREAD_COUNT
+
+namespace ECS
+{
+    /**
+     * @class ThreadPool
+     * @brief Persistent pool of worker threads running parallel loops.
+     *
+     * @note The threads are started once and sleep between two loops, so a parallel loop only costs a wake-up and
+     * not a thread creation.
+     * @note The thread calling run() takes jobs too, and run() only returns once every job is done.
+     */
+    class ThreadPool
+    {
+        public:
+            /*===================//
+            //  Singleton Logic  //
+            //===================*/
+
+            /**
+             * @brief Get the thread pool shared by the worlds.
+             *
+             * @return ThreadPool & The pool, started on first use with ECS_THREAD_COUNT workers.
+             */
+            static ThreadPool &getThreadPool()
+            {
+                static ThreadPool pool(ECS_THREAD_COUNT);
+
+                return pool;
+            }
+
+            ThreadPool &operator=(const ThreadPool &pool) = delete;
+            ThreadPool(const ThreadPool &pool)            = delete;
+
+            /*============================//
+            //  Constructor / Destructor  //
+            //============================*/
+
+            /**
+             * @brief Construct a new ThreadPool object and start its workers.
+             *
+             * @param threadCount The number of workers, 0 uses one per hardware core minus the calling thread.
+             */
+            explicit ThreadPool(std::size_t threadCount = 0)
+                : _threads(), _mutex(), _runMutex(), _wakeCondition(), _doneCondition(), _job(), _jobCount(0),
+                  _nextJob(0), _activeThreads(0), _generation(0), _error(), _stop(false)
+            {
+                if (threadCount == 0) threadCount = std::max(std::thread::hardware_concurrency(), 2U) - 1;
+                for (std::size_t i = 0; i < threadCount; i++)
+                    _threads.emplace_back(&ThreadPool::work, this, i + 1);
+            }
+
+            /**
+             * @brief Destroy the ThreadPool object, waiting for its workers to stop.
+             */
+            ~ThreadPool()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    _stop = true;
+                }
+                _wakeCondition.notify_all();
+                for (std::thread &thread : _threads)
+                    thread.join();
+            }
+
+            /*================//
+            //  Parallel Run  //
+            //================*/
+
+            /**
+             * @brief Run jobs 0 to count - 1 on the workers and the calling thread, and wait for all of them.
+             *
+             * @param count The number of jobs.
+             * @param job The function called with the index of each job, from any thread.
+             * @throw Rethrows the first exception thrown by a job, once every job is done.
+             * @note Called from a job (a parallel loop inside a parallel loop), the jobs run on the calling thread.
+             * @note Loops started by different threads at the same time run one after the other.
+             */
+            void run(std::size_t count, const std::function<void(std::size_t)> &job)
+            {
+                if (count == 0) return;
+                if (count == 1 || _threads.empty() || isInJob()) {
+                    for (std::size_t i = 0; i < count; i++)
+                        job(i);
+                    return;
+                }
+
+                std::lock_guard<std::mutex> runLock(_runMutex);
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    _job           = &job;
+                    _jobCount      = count;
+                    _activeThreads = _threads.size();
+                    _error         = nullptr;
+                    _nextJob.store(0);
+                    _generation++;
+                }
+                _wakeCondition.notify_all();
+                isRunning() = true;
+                runJobs();
+                isRunning() = false;
+
+                std::unique_lock<std::mutex> lock(_mutex);
+                _doneCondition.wait(lock, [this]() { return _activeThreads == 0; });
+                _job = nullptr;
+                if (_error) std::rethrow_exception(_error);
+            }
+
+            /*===================//
+            //  Getters/Setters  //
+            //===================*/
+
+            std::size_t getThreadCount() const
+            {
+                return _threads.size();
+            }
+
+            /**
+             * @brief Get the index of the calling thread.
+             *
+             * @return std::size_t 1 to getThreadCount() on the workers of a pool, 0 on any other thread.
+             * @note Lets the callers of run() keep one slot of data per thread, see World::commands().
+             */
+            static std::size_t getThreadIndex()
+            {
+                return threadIndex();
+            }
+
+            /**
+             * @brief Check if the calling thread is running a job, run() then runs the jobs on this thread only.
+             */
+            static bool isInJob()
+            {
+                return threadIndex() != 0 || isRunning();
+            }
+
+        private:
+            static bool &isRunning()
+            {
+                static thread_local bool running = false;
+
+                return running;
+            }
+
+            static std::size_t &threadIndex()
+            {
+                static thread_local std::size_t index = 0;
+
+                return index;
+            }
+
+            void work(std::size_t index)
+            {
+                std::size_t generation = 0;
+
+                threadIndex() = index;
+                while (true) {
+                    {
+                        std::unique_lock<std::mutex> lock(_mutex);
+                        _wakeCondition.wait(lock, [&]() { return _stop || _generation != generation; });
+                        if (_stop) return;
+                        generation = _generation;
+                    }
+                    runJobs();
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    if (--_activeThreads == 0) _doneCondition.notify_one();
+                }
+            }
+
+            void runJobs()
+            {
+                for (std::size_t i = _nextJob++; i < _jobCount; i = _nextJob++) {
+                    try {
+                        (*_job)(i);
+                    } catch (...) {
+                        std::lock_guard<std::mutex> lock(_mutex);
+                        if (!_error) _error = std::current_exception();
+                    }
+                }
+            }
+
+            /*==============//
+            //  Attributes  //
+            //==============*/
+
+            std::vector<std::thread>                 _threads;
+            std::mutex                               _mutex;
+            std::mutex                               _runMutex;
+            std::condition_variable                  _wakeCondition;
+            std::condition_variable                  _doneCondition;
+            const std::function<void(std::size_t)> *_job;
+            std::size_t                              _jobCount;
+            std::atomic<std::size_t>                 _nextJob;
+            std::size_t                              _activeThreads;
+            std::size_t                              _generation;
+            std::exception_ptr                       _error;
+            bool                                     _stop;
+    };
+} // namespace ECS
@@ -7,15 +7,42 @@
 
 #pragma once
 
+#include <atomic>
+#include <bitset>
 #include <cstddef>
+#include <initializer_list>
+#include <type_traits>
 
-#define ECS_TYPEID(T) typeid(T).hash_code()
+#define ECS_TYPEID(T)  ECS::Utils::getTypeId<ECS::ComponentFamily, std::remove_cvref_t<T>>()
+#define ECS_EVENTID(T) ECS::Utils::getTypeId<ECS::EventFamily, std::remove_cvref_t<T>>()
+
+#ifndef ECS_MAX_COMPONENTS    // Maximum number of component types, sets the width of the component signatures
+#define ECS_MAX_COMPONENTS 64 // (a multiple of 64 keeps them in whole machine words)
+#endif                        // !ECS_MAX_COMPONENTS
 
 namespace ECS
 {
     typedef std::size_t id_t;
     typedef std::size_t type_t;
 
+    static_assert(sizeof(id_t) >= 8, "Entity identifiers pack a 32 bits index and a 32 bits generation");
+
+    /**
+     * @brief Set of component types, bit N is set when the component type of identifier N is present.
+     *
+     * @note Identifies the components of an entity or an archetype, and the requirements of a query: an entity
+     * matches a query when (entity & query) == query.
+     */
+    typedef std::bitset<ECS_MAX_COMPONENTS> Signature;
+
+    /**
+     * @brief Families of type identifiers, each family numbers its types from 0 independently of the others.
+     */
+    struct ComponentFamily {};
+    struct EventFamily {};
+    struct QueryFamily {};
+    struct ResourceFamily {};
+
     /**
      * @class Utils
      * @brief Utility class for the ECS.
@@ -42,5 +69,108 @@ namespace ECS
                 }
                 return id++;
             }
+
+            /*======================//
+            //  Entity Identifiers  //
+            //======================*/
+
+            /**
+             * @brief Build the identifier of an entity.
+             *
+             * @param index The index of the slot of the entity in its World.
+             * @param generation The generation of the slot, bumped every time the entity of the slot is destroyed.
+             * @return id_t The identifier, the index in the low 32 bits and the generation in the high 32 bits.
+             * @note Identifiers of destroyed entities never become valid again, even once their slot is reused.
+             */
+            static constexpr id_t makeEntityId(std::size_t index, std::size_t generation)
+            {
+                return static_cast<id_t>(index) | (static_cast<id_t>(generation) << 32);
+            }
+
+            static constexpr std::size_t getEntityIndex(id_t id)
+            {
+                return static_cast<std::size_t>(id & 0xFFFFFFFF);
+            }
+
+            static constexpr std::size_t getEntityGeneration(id_t id)
+            {
+                return static_cast<std::size_t>(id >> 32);
+            }
+
+            /*====================//
+            //  Type Identifiers  //
+            //====================*/
+
+            /**
+             * @brief Get the dense identifier of a type.
+             *
+             * @tparam Family The family the identifier belongs to (ComponentFamily, EventFamily...).
+             * @tparam T The type to identify.
+             * @return type_t The identifier of the type, types of a family are numbered 0, 1, 2... in order of first
+             * use, so identifiers can index arrays.
+             * @note Prefer ECS_TYPEID and ECS_EVENTID. Unlike typeid(T).hash_code(), this does not need RTTI and the
+             * identifier is computed once per type instead of on every call.
+             * @warning Identifiers depend on the order types are first used, never send them over the network.
+             */
+            template <typename Family, typename T> static type_t getTypeId()
+            {
+                static const type_t id = getTypeCounter<Family>()++;
+
+                return id;
+            }
+
+            /**
+             * @brief Get the number of types identified so far in a family.
+             *
+             * @tparam Family The family of identifiers.
+             * @return type_t One past the highest identifier given in this family.
+             */
+            template <typename Family> static type_t getTypeCount()
+            {
+                return getTypeCounter<Family>().load();
+            }
+
+            /**
+             * @brief Get the signature made of a list of component types.
+             *
+             * @tparam Types The component types.
+             * @return const Signature & The signature, computed once per list of types.
+             * @throw std::out_of_range if a component type identifier reaches ECS_MAX_COMPONENTS.
+             */
+            template <typename... Types> static const Signature &getSignature()
+            {
+                static const Signature signature = makeSignature({ECS_TYPEID(Types)...});
+
+                return signature;
+            }
+
+            /**
+             * @brief Check if a signature holds every component type of another one.
+             *
+             * @param signature The signature to check, usually the one of an entity or an archetype.
+             * @param required The component types that must be present.
+             * @return bool True if every bit of required is set in signature.
+             */
+            static bool matches(const Signature &signature, const Signature &required)
+            {
+                return (signature & required) == required;
+            }
+
+        private:
+            static Signature makeSignature(std::initializer_list<type_t> types)
+            {
+                Signature signature;
+
+                for (type_t type : types)
+                    signature.set(type);
+                return signature;
+            }
+
+            template <typename Family> static std::atomic<type_t> &getTypeCounter()
+            {
+                static std::atomic<type_t> counter = 0;
+
+                return counter;
+            }
     };
 } // namespace ECS
@@ -7,16 +7,31 @@
 
 #pragma once
 
+#include <algorithm>
 #include <ctime>
-#include <functional>
+#include <limits>
 #include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
+#include "CommandBuffer.hpp"
 #include "ECS/Components.hpp"
 #include "ECS/System.hpp"
 #include "Engine/Engine.hpp"
 #include "Entity.hpp"
+#include "EventChannel.hpp"
 #include "EventSubscriber.hpp"
+#include "MemoryStats.hpp"
+#include "Prefab.hpp"
+#include "Query.hpp"
+#include "SparseSet.hpp"
+#include "Storage.hpp"
+#include "ThreadPool.hpp"
 #include "Utilities.hpp"
 
 #if defined(WIN32) || defined(_WIN32) || defined(__WIN32__) || defined(__NT__)
@@ -40,22 +55,36 @@ namespace ECS
         public:
             /**
              * @brief Construct a new World object.
+             *
+             * @param storageType The component storage backend of the world.
+             * @note Use StorageType::SparseSet for worlds where components are constantly added and removed.
              */
-            World() : _entities(), _subscribers(), _clock(), _engine(Engine::EngineClass::getEngine()) {}
+            explicit World(StorageType storageType = StorageType::Archetype)
+                : _storageType(storageType), _storage(), _queries(), _entities(), _freeSlots(), _hierarchyRoots(),
+                  _commandBuffers(ThreadPool::getThreadPool().getThreadCount() + 1), _resources(), _prefabs(),
+                  _channels(), _pendingChannels(), _flushedChannels(), _systems(), _systemsOrder(), _stages(),
+                  _lastSystems(), _stageBuffers(), _scheduleChanged(false), _clock(),
+                  _engine(Engine::EngineClass::getEngine())
+            {
+                if (storageType == StorageType::SparseSet)
+                    _storage = std::make_unique<SparseSetStorage>();
+                else
+                    _storage = std::make_unique<ArchetypeStorage>();
+            }
 
             /**
              * @brief Destroy the World object.
              * @note This will also destroy all entities and global entities within the world.
+             * @note The storage and the queries are dropped as a whole before the entities, so destroying an entity
+             * does not move rows, update queries nor log changes: the teardown only runs the destructors of the
+             * entities and their components, whose memory goes back to the pools of ComponentAllocator.
              */
             ~World()
             {
-                _systems.clear();
+                if (_storage) _dropStorage();
                 _entities.clear();
-                for (auto &sub : _subscribers) {
-                    for (auto &pair : sub.second) {
-                        delete pair.second;
-                    }
-                }
+                _freeSlots.clear();
+                _channels.clear();
             }
 
             /*===================//
@@ -67,15 +96,14 @@ namespace ECS
              *
              * @param id the id of the entity
              * @return bool if it exists true
+             * @note Ids of destroyed entities are detected as stale even once their slot is reused.
              */
-            bool entityExists(id_t entityId)
+            bool entityExists(id_t entityId) const
             {
-                for (const auto &entity : _entities) {
-                    if (entity.first == entityId) {
-                        return true;
-                    }
-                }
-                return false;
+                std::size_t index = Utils::getEntityIndex(entityId);
+
+                return index < _entities.size() && _entities[index].entity &&
+                       _entities[index].generation == Utils::getEntityGeneration(entityId);
             }
 
             /**
@@ -85,38 +113,57 @@ namespace ECS
              * World.
              * @return id_t The unique identifier for the added entity.
              * @note The World class takes ownership of the Entity, ensuring proper management and cleanup.
+             * @note The slots of destroyed entities are reused first, so ids stay small.
              */
             id_t addEntity(std::unique_ptr<Entity> entity)
             {
-                type_t                  id = Utils::getNewId<Entity>();
-                Events::OnEntityCreated event{entity.get()};
+                std::size_t index = _entities.size();
 
-                entity->setId(id);
-                _entities.emplace(id, std::move(entity));
-                if (_subscribers.find(ECS_TYPEID(Events::OnEntityCreated)) != _subscribers.end())
-                    broadcastEvent<Events::OnEntityCreated>(event);
-                return id;
+                if (!_freeSlots.empty()) {
+                    index = _freeSlots.back();
+                    _freeSlots.pop_back();
+                } else {
+                    _entities.emplace_back();
+                }
+                return _emplaceEntity(Utils::makeEntityId(index, _entities[index].generation), std::move(entity));
             }
 
+            /**
+             * @brief Id returned by addEntity(id_t) when the id is not mirrored.
+             */
+            static constexpr id_t noEntity = std::numeric_limits<id_t>::max();
+
             /**
              * @brief Create an empty entity with an id.
              *
              * @param id The unique identifier for the created entity.
-             * @return id_t The unique identifier for the created entity.
+             * @return id_t The unique identifier for the created entity, noEntity if the id is ignored.
              * @note if the id is already an entity id, it will return the id
+             * @note Used to mirror the entities of a remote world: an older mirrored entity still using the slot of
+             * the id is stale and gets destroyed, and the slots skipped to reach the id are kept for the next remote
+             * ids. An id older than the slot is ignored, and so is an id whose slot holds an entity created locally,
+             * which is never destroyed for a remote one.
              */
             id_t addEntity(id_t id)
             {
                 if (entityExists(id)) return id;
-                Utils::getNewId<Entity>(id);
-                std::unique_ptr<Entity> entity = std::make_unique<Entity>();
-                Events::OnEntityCreated event{entity.get()};
 
-                entity->setId(id);
-                _entities.emplace(id, std::move(entity));
-                if (_subscribers.find(ECS_TYPEID(Events::OnEntityCreated)) != _subscribers.end())
-                    broadcastEvent<Events::OnEntityCreated>(event);
-                return id;
+                std::size_t index = Utils::getEntityIndex(id);
+
+                if (index >= _entities.size()) {
+                    _entities.resize(index + 1);
+                } else {
+                    EntitySlot &slot = _entities[index];
+
+                    if (Utils::getEntityGeneration(id) < slot.generation) return noEntity;
+                    if (slot.entity && !slot.mirrored) return noEntity;
+                    destroyEntity(Utils::makeEntityId(index, slot.generation));
+                    auto freeSlot = std::find(_freeSlots.begin(), _freeSlots.end(), index);
+                    if (freeSlot != _freeSlots.end()) _freeSlots.erase(freeSlot);
+                }
+                _entities[index].generation = Utils::getEntityGeneration(id);
+                _entities[index].mirrored   = true;
+                return _emplaceEntity(id, std::make_unique<Entity>());
             }
 
             /**
@@ -149,27 +196,133 @@ namespace ECS
                 return id;
             }
 
+            /**
+             * @brief Register a prefab, a template of entity to spawn later.
+             *
+             * @param name The name of the prefab, a prefab already registered under this name is replaced.
+             * @param prefab The prefab, its components are built once here and copied on every spawn.
+             */
+            void registerPrefab(const std::string &name, Prefab &&prefab)
+            {
+                _prefabs[name] = std::move(prefab);
+            }
+
+            /**
+             * @brief Spawn entities from a registered prefab.
+             *
+             * @param name The name of the prefab.
+             * @param count The number of entities to spawn.
+             * @return std::vector<id_t> The unique identifiers of the spawned entities.
+             * @throw std::out_of_range if no prefab is registered under this name.
+             * @note The entity table grows once for the whole batch, and each entity gets all its components before
+             * joining the storage, so it is filed once instead of moving through an archetype per component.
+             */
+            std::vector<id_t> spawn(const std::string &name, std::size_t count = 1)
+            {
+                auto prefab = _prefabs.find(name);
+
+                if (prefab == _prefabs.end()) throw std::out_of_range("World::spawn: unknown prefab " + name);
+                return spawn(prefab->second, count);
+            }
+
+            /**
+             * @brief Spawn entities from a prefab.
+             *
+             * @param prefab The prefab.
+             * @param count The number of entities to spawn.
+             * @return std::vector<id_t> The unique identifiers of the spawned entities.
+             */
+            std::vector<id_t> spawn(const Prefab &prefab, std::size_t count = 1)
+            {
+                std::vector<id_t> ids;
+
+                ids.reserve(count);
+                if (count > _freeSlots.size()) _entities.reserve(_entities.size() + count - _freeSlots.size());
+                prefab.reserveComponents(count);
+                for (std::size_t i = 0; i < count; i++)
+                    ids.push_back(addEntity(prefab.instantiate()));
+                return ids;
+            }
+
+            /**
+             * @brief Fill the component pools ahead of a burst of entity creations.
+             *
+             * @tparam Components The component types to reserve.
+             * @param count The number of components of each type to create without the pools growing.
+             * @note Components are allocated from pools of fixed size blocks (see ComponentAllocator), this moves the
+             * growth of the pools out of the frame that creates the components.
+             */
+            template <typename... Components> void reserveComponents(std::size_t count)
+            {
+                (ComponentAllocator::reserve(sizeof(Components), count), ...);
+            }
+
+            /**
+             * @brief Destroy part of the entities, to spread the teardown of a world over several frames.
+             *
+             * @param budget The maximum number of entities to destroy.
+             * @return bool True once every entity is destroyed, deleting the world is then cheap.
+             * @note The systems, the queries and the storage are dropped at the first call, see ~World().
+             * @warning Meant for worlds that are being deleted: the world is unusable after the first call.
+             */
+            bool releaseEntities(std::size_t budget)
+            {
+                if (_storage) _dropStorage();
+                while (!_entities.empty() && budget > 0) {
+                    if (_entities.back().entity) budget--;
+                    _entities.pop_back();
+                }
+                return _entities.empty();
+            }
+
             /**
              * @brief Remove an entity from the world.
              *
              * @param id The unique identifier of the entity to be removed.
-             * @note The entity will be properly destroyed when removed.
+             * @note The entity is destroyed at the next sync point, see commands().
              */
             void removeEntity(id_t id)
             {
-                _entitiesToDelete.push_back(id);
+                commands().destroyEntity(id);
             }
 
             /**
              * @brief Remove an entity from the world.
              *
              * @param entity The entity to be removed.
-             * @note The entity will be properly destroyed when removed.
+             * @note The entity is destroyed at the next sync point, see commands().
              */
             void removeEntity(ECS::Entity *entity)
             {
-                id_t id = entity->getId();
-                _entitiesToDelete.push_back(id);
+                commands().destroyEntity(entity->getId());
+            }
+
+            /**
+             * @brief Destroy an entity right away.
+             *
+             * @param id The unique identifier of the entity to destroy, stale or unknown ids are ignored.
+             * @note The slot of the entity gets a new generation and is reused by the next created entity.
+             * @note The children of the entity are destroyed with it, see setParent().
+             * @warning Prefer removeEntity() from the systems, this is meant to be called between two sync points.
+             */
+            void destroyEntity(id_t id)
+            {
+                if (!entityExists(id)) return;
+
+                std::size_t       index = Utils::getEntityIndex(id);
+                std::vector<id_t> children;
+
+                removeParent(id);
+                _removeHierarchyRoot(id);
+                children.swap(_entities[index].children);
+                _entities[index].entity.reset();
+                _entities[index].generation++;
+                _entities[index].mirrored = false;
+                _freeSlots.push_back(index);
+                for (id_t child : children) {
+                    _entities[Utils::getEntityIndex(child)].parent = noParent;
+                    destroyEntity(child);
+                }
             }
 
             /**
@@ -180,7 +333,8 @@ namespace ECS
              */
             const Entity &getEntity(id_t id) const
             {
-                return *_entities.at(id);
+                if (!entityExists(id)) throw std::out_of_range("World::getEntity: unknown or destroyed entity");
+                return *_entities[Utils::getEntityIndex(id)].entity;
             }
 
             /**
@@ -192,83 +346,66 @@ namespace ECS
              */
             Entity &getMutEntity(id_t id)
             {
-                return *_entities.at(id);
+                if (!entityExists(id)) throw std::out_of_range("World::getMutEntity: unknown or destroyed entity");
+                return *_entities[Utils::getEntityIndex(id)].entity;
             }
 
             /**
-             * @brief get all entities that have a specific component type.
-             * @tparam T The component type to filter entities.
+             * @brief Call a function on every entity of the world.
              *
-             * @return std::vector<Entity *> A vector of pointers to the entities.
+             * @param func The function called with a pointer to each entity.
+             * @note Entities created during the iteration are not visited.
              */
-            template <typename T> std::unordered_map<Entity *, ComponentHandle<T>> get()
+            template <typename Func> void eachEntity(Func &&func)
             {
-                std::unordered_map<Entity *, ComponentHandle<T>> entities;
-                for (auto &pair : _entities) {
-                    Entity &entity = *pair.second;
-                    if (entity.has<T>()) {
-                        ComponentHandle<T> component = entity.getComponent<T>();
-                        entities.emplace(&entity, component);
-                    }
+                std::size_t count = _entities.size();
+
+                for (std::size_t index = 0; index < count; index++) {
+                    if (_entities[index].entity) func(_entities[index].entity.get());
                 }
-                return entities;
             }
 
             /**
-             * @brief Iterates over all entities that have a specific component type.
-             *
+             * @brief get all entities that have a specific component type.
              * @tparam T The component type to filter entities.
-             * @param func The callable function that will be applied to each entity and its component.
+             *
+             * @return std::vector<Entity *> A vector of pointers to the entities.
              */
-            template <typename T> void each(std::function<void(Entity *, ComponentHandle<T>)> func)
+            template <typename T> std::unordered_map<Entity *, ComponentHandle<T>> get()
             {
-                auto entities = getEntitiesWithComponents<T>();
-                for (auto &entity : entities) {
-                    if (!entity->template has<T>()) continue;
-                    auto component = entity->template getComponent<T>();
-                    func(entity, component);
-                }
+                std::unordered_map<Entity *, ComponentHandle<T>> entities;
+
+                query<T>().each(
+                    [&](Entity *entity, ComponentHandle<T> component) { entities.emplace(entity, component); });
+                return entities;
             }
 
             /**
              * @brief Iterates over all entities that have a specific set of component types.
              *
-             * @tparam T The component type to filter entities.
-             * @tparam U The component type to filter entities.
-             * @param func The callable function that will be applied to each entity and its component.
+             * @tparam Types The component types to filter entities.
+             * @param func The callable applied to each entity and its components, taking either an Entity * followed
+             * by a ComponentHandle<T> or a T & for each component type (see Query::each).
+             * @note The callable is not wrapped in a std::function, so lambdas are inlined in the iteration loop.
              */
-            template <typename T, typename U>
-            void each(std::function<void(Entity *, ComponentHandle<T>, ComponentHandle<U>)> func)
+            template <typename... Types, typename Func> void each(Func &&func)
             {
-                auto entities = getEntitiesWithComponents<T, U>();
-                for (auto &entity : entities) {
-                    if (!(entity->template has<T>() && entity->template has<U>())) continue;
-
-                    auto componentT = entity->template getComponent<T>();
-                    auto componentU = entity->template getComponent<U>();
-                    func(entity, componentT, componentU);
-                }
+                query<Types...>().each(std::forward<Func>(func));
             }
 
             /**
-             * @brief Iterates over all entities that have a specific set of component types.
-             * @tparam T The component type to filter entities.
-             * @tparam U The component type to filter entities.
-             * @param func The callable function that will be applied to each entity and its component.
+             * @brief Iterates over all entities that have a specific set of component types, on several threads.
+             *
+             * @tparam Types The component types to filter entities.
+             * @param func The callable applied to each entity and its components, with the same parameters as each().
+             * @warning The callable runs on the threads of the shared ThreadPool at the same time: it may only write
+             * the components it is given, and must not add or remove entities or components, nor broadcast events
+             * (see Query::parallelEach).
+             * @note Meant for systems whose work on an entity does not depend on the other entities.
              */
-            template <typename T, typename U, typename V>
-            void each(std::function<void(Entity *, ComponentHandle<T>, ComponentHandle<U>, ComponentHandle<V>)> func)
+            template <typename... Types, typename Func> void parallelEach(Func &&func)
             {
-                auto entities = getEntitiesWithComponents<T, U, V>();
-                for (auto &entity : entities) {
-                    if (!(entity->template has<T>() && entity->template has<U>() && entity->template has<V>()))
-                        continue;
-
-                    auto componentT = entity->template getComponent<T>();
-                    auto componentU = entity->template getComponent<U>();
-                    auto componentV = entity->template getComponent<V>();
-                    func(entity, componentT, componentU, componentV);
-                }
+                query<Types...>().parallelEach(std::forward<Func>(func), ThreadPool::getThreadPool());
             }
 
             /**
@@ -280,12 +417,8 @@ namespace ECS
             template <typename... Types> std::vector<Entity *> getEntitiesWithComponents()
             {
                 std::vector<Entity *> entities;
-                for (auto &pair : _entities) {
-                    Entity &entity = *pair.second;
-                    if (entity.has<Types...>()) {
-                        entities.push_back(&entity);
-                    }
-                }
+
+                query<Types...>().collect(entities);
                 return entities;
             }
 
@@ -297,11 +430,183 @@ namespace ECS
              */
             template <typename... Types> Entity *getEntityWithComponents()
             {
-                std::vector<Entity *> entities = getEntitiesWithComponents<Types...>();
+                return query<Types...>().first();
+            }
+
+            /**
+             * @brief Get the persistent query on every entity that have a set of given components.
+             *
+             * @tparam Types The component types to filter entities.
+             * @return Query<Types...> & The query, created on first use and kept up to date by the world.
+             * @note Prefer keeping the query around over calling getEntitiesWithComponents() every frame, iterating it
+             * only costs the number of matching entities.
+             * @note Only locks when called from the systems of a parallel stage, which may create queries at once.
+             */
+            template <typename... Types> Query<Types...> &query()
+            {
+                std::unique_lock<std::mutex> lock(_queriesMutex, std::defer_lock);
+                type_t                       index = Utils::getTypeId<QueryFamily, Query<Types...>>();
+
+                if (ThreadPool::isInJob()) lock.lock();
+                if (index >= _queries.size()) _queries.resize(index + 1);
+                auto &query = _queries[index];
+                if (!query) {
+                    auto created = std::make_unique<Query<Types...>>(*_storage, _storageType);
+                    _storage->addQuery(created.get());
+                    query = std::move(created);
+                }
+                return static_cast<Query<Types...> &>(*query);
+            }
+
+            /*======================//
+            //  Hierarchy Handling  //
+            //======================*/
+
+            /**
+             * @brief Parent of the entities that have none.
+             */
+            static constexpr id_t noParent = std::numeric_limits<id_t>::max();
+
+            /**
+             * @brief Attach an entity to a parent entity.
+             *
+             * @param child The unique identifier of the child, detached from its previous parent.
+             * @param parent The unique identifier of the parent.
+             * @throw std::out_of_range if one of the entities does not exist.
+             * @throw std::invalid_argument if the child is the parent or one of its ancestors.
+             * @note Children are destroyed with their parent. The Transform system keeps the position of each child
+             * at the position of its parent plus its TransformComponent.
+             */
+            void setParent(id_t child, id_t parent)
+            {
+                if (!entityExists(child) || !entityExists(parent))
+                    throw std::out_of_range("World::setParent: unknown or destroyed entity");
+                for (id_t ancestor = parent; ancestor != noParent; ancestor = getParent(ancestor)) {
+                    if (ancestor == child) throw std::invalid_argument("World::setParent: the child is an ancestor");
+                }
+                removeParent(child);
 
-                if (entities.empty()) return nullptr;
+                EntitySlot &parentSlot = _entities[Utils::getEntityIndex(parent)];
 
-                return entities[0];
+                if (parentSlot.children.empty() && parentSlot.parent == noParent) _hierarchyRoots.push_back(parent);
+                parentSlot.children.push_back(child);
+                _entities[Utils::getEntityIndex(child)].parent = parent;
+                _removeHierarchyRoot(child);
+            }
+
+            /**
+             * @brief Detach an entity from its parent, it keeps its own children.
+             *
+             * @param child The unique identifier of the child, ignored if it does not exist or has no parent.
+             */
+            void removeParent(id_t child)
+            {
+                if (!entityExists(child)) return;
+
+                EntitySlot &slot = _entities[Utils::getEntityIndex(child)];
+
+                if (slot.parent == noParent) return;
+
+                EntitySlot        &parentSlot = _entities[Utils::getEntityIndex(slot.parent)];
+                std::vector<id_t> &siblings   = parentSlot.children;
+
+                siblings.erase(std::find(siblings.begin(), siblings.end(), child));
+                if (siblings.empty() && parentSlot.parent == noParent) _removeHierarchyRoot(slot.parent);
+                slot.parent = noParent;
+                if (!slot.children.empty()) _hierarchyRoots.push_back(child);
+            }
+
+            /**
+             * @brief Get the parent of an entity.
+             *
+             * @param id The unique identifier of the entity.
+             * @return id_t The unique identifier of the parent, noParent if the entity has none.
+             * @throw std::out_of_range if the entity does not exist.
+             */
+            id_t getParent(id_t id) const
+            {
+                if (!entityExists(id)) throw std::out_of_range("World::getParent: unknown or destroyed entity");
+                return _entities[Utils::getEntityIndex(id)].parent;
+            }
+
+            /**
+             * @brief Get the children of an entity.
+             *
+             * @param id The unique identifier of the entity.
+             * @return const std::vector<id_t> & The unique identifiers of the children, in the order they were added.
+             * @throw std::out_of_range if the entity does not exist.
+             */
+            const std::vector<id_t> &getChildren(id_t id) const
+            {
+                if (!entityExists(id)) throw std::out_of_range("World::getChildren: unknown or destroyed entity");
+                return _entities[Utils::getEntityIndex(id)].children;
+            }
+
+            /**
+             * @brief Call a function on the root of every hierarchy: the entities with children but no parent.
+             *
+             * @param func The function called with a pointer to each root.
+             * @note Walking the hierarchies from their roots visits each parent before its children, and skips the
+             * entities outside of any hierarchy.
+             */
+            template <typename Func> void eachHierarchyRoot(Func &&func)
+            {
+                for (std::size_t i = 0; i < _hierarchyRoots.size(); i++)
+                    func(_entities[Utils::getEntityIndex(_hierarchyRoots[i])].entity.get());
+            }
+
+            /*=====================//
+            //  Resource Handling  //
+            //=====================*/
+
+            /**
+             * @brief Create the resource of a type, the single instance of data the whole world shares.
+             *
+             * @tparam T The type of the resource, any type.
+             * @param args The arguments forwarded to the constructor of the resource.
+             * @return T & The resource, owned by the world and replacing the previous one of this type.
+             */
+            template <typename T, typename... Args> T &emplaceResource(Args &&...args)
+            {
+                type_t index = Utils::getTypeId<ResourceFamily, T>();
+
+                if (index >= _resources.size()) _resources.resize(index + 1);
+                _resources[index] = std::make_shared<T>(std::forward<Args>(args)...);
+                return *static_cast<T *>(_resources[index].get());
+            }
+
+            /**
+             * @brief Destroy the resource of a type.
+             *
+             * @tparam T The type of the resource.
+             */
+            template <typename T> void removeResource()
+            {
+                type_t index = Utils::getTypeId<ResourceFamily, T>();
+
+                if (index < _resources.size()) _resources[index].reset();
+            }
+
+            /**
+             * @brief Get the resource of a type.
+             *
+             * @tparam T The type of the resource.
+             * @return T * The resource, nullptr if there is none.
+             * @note An array access when the resource was created with emplaceResource(). Without a resource of its
+             * type, a component owned by a single entity is returned from the first entity owning one, through the
+             * persistent query of the type. The view and the progress of the world take this path: they are created
+             * by the game worlds and replicated with their entity, so they stay components.
+             */
+            template <typename T> T *resource()
+            {
+                type_t index = Utils::getTypeId<ResourceFamily, T>();
+
+                if (index < _resources.size() && _resources[index]) return static_cast<T *>(_resources[index].get());
+                if constexpr (std::is_base_of_v<BaseComponent, T>) {
+                    Entity *entity = query<T>().first();
+                    if (entity) return entity->getComponent<T>()();
+                }
+                return nullptr;
             }
 
             /*==================//
@@ -314,18 +619,11 @@ namespace ECS
              * @param subscriber A pointer to the EventSubscriber object.
              * @return id_t The unique identifier for the subscription.
              * @note This method allows for the dynamic subscription of event handlers to specific event types.
+             * @note The subscribers still subscribed are deleted with the world.
              */
             template <typename T> id_t subscribe(const EventSubscriber<T> *subscriber)
             {
-                auto type_id = ECS_TYPEID(T);
-                auto uuid    = Utils::getNewId<T>();
-
-                if (_subscribers.find(type_id) == _subscribers.end())
-                    _subscribers.emplace(type_id, std::unordered_map<id_t, BaseEventSubscriber *>());
-
-                _subscribers[type_id].emplace(
-                    uuid, static_cast<BaseEventSubscriber *>(const_cast<EventSubscriber<T> *>(subscriber)));
-                return uuid;
+                return getChannel<T>().subscribe(const_cast<EventSubscriber<T> *>(subscriber));
             }
 
             /**
@@ -336,10 +634,10 @@ namespace ECS
              */
             template <typename T> void unsubscribe(id_t uuid)
             {
-                auto type_id = ECS_TYPEID(T);
+                type_t type = ECS_EVENTID(T);
 
-                if (_subscribers.find(type_id) == _subscribers.end()) return;
-                _subscribers[type_id].erase(uuid);
+                if (type < _channels.size() && _channels[type])
+                    static_cast<EventChannel<T> &>(*_channels[type]).unsubscribe(uuid);
             }
 
             /**
@@ -347,19 +645,50 @@ namespace ECS
              *
              * @tparam T The type of the event data to be broadcast.
              * @param data The event data to be broadcast.
-             * @param name The name of the event.
-             * @note This method allows for the dynamic broadcasting of events to all subscribers of a specific event
-             * type.
+             * @note The subscribers receive the event in subscription order, an event type nobody subscribed to costs
+             * a bounds check.
              * @warning This method can cause infinite recursion if its broadcasting an event of type T or it broadcast
              */
-            template <typename T> void broadcastEvent(T data, const std::string name = "")
+            template <typename T> void broadcastEvent(const T &data)
             {
-                const std::unordered_map<id_t, BaseEventSubscriber *> &subscribers = _subscribers[ECS_TYPEID(T)];
+                type_t type = ECS_EVENTID(T);
 
-                for (auto &subscriber : subscribers) {
-                    auto *sub = static_cast<EventSubscriber<T> *>(subscriber.second);
-                    sub->receiveEvent(name, data);
-                }
+                if (type < _channels.size() && _channels[type])
+                    static_cast<EventChannel<T> &>(*_channels[type]).broadcast(data);
+            }
+
+            /**
+             * @brief Queue an event, the subscribers receive it with the other events of its type at the next flush.
+             *
+             * @tparam T The type of the event data to be queued.
+             * @param data The event data to be queued.
+             * @note tick() flushes the queued events after each stage of systems, before the sync point that applies
+             * the recorded commands, so the entities referenced by the events are still alive when they are delivered.
+             * Subscribers get the whole batch at once, see EventSubscriber::receiveEvents().
+             * @warning Call it from the thread running the world, not from a parallel iteration.
+             */
+            template <typename T> void queueEvent(const T &data)
+            {
+                type_t type = ECS_EVENTID(T);
+
+                if (type >= _channels.size() || !_channels[type]) return;
+
+                auto &channel = static_cast<EventChannel<T> &>(*_channels[type]);
+
+                if (!channel.empty() && channel.queue(data)) _pendingChannels.push_back(&channel);
+            }
+
+            /**
+             * @brief Deliver every queued event, one batch per event type, in the order the types were first queued.
+             *
+             * @note Events queued while delivering wait for the next flush.
+             */
+            void flushEvents()
+            {
+                _flushedChannels.swap(_pendingChannels);
+                for (BaseEventChannel *channel : _flushedChannels)
+                    channel->flush();
+                _flushedChannels.clear();
             }
 
             /*====================//
@@ -376,7 +705,7 @@ namespace ECS
              */
             template <typename System, typename... types> void addSystem(std::string name, types &&...args)
             {
-                _systems.emplace(name, std::make_unique<System>(*this, std::forward<types>(args)...));
+                _addSystem(std::move(name), std::make_unique<System>(*this, std::forward<types>(args)...));
             }
 
             /**
@@ -387,7 +716,7 @@ namespace ECS
              */
             template <typename System> void addSystem(std::string name)
             {
-                _systems.emplace(name, std::make_unique<System>(*this));
+                _addSystem(std::move(name), std::make_unique<System>(*this));
             }
 
             /*==================//
@@ -405,29 +734,176 @@ namespace ECS
                 return _clock.getElapsedTime();
             }
 
+            /*===================//
+            //  Command Buffers  //
+            //===================*/
+
+            /**
+             * @brief Get the command buffer of the calling thread.
+             *
+             * @return CommandBuffer & The buffer to record structural changes into, played back at the next sync point.
+             * @note The game loop thread and the threads of the shared ThreadPool each get their own buffer, so the
+             * systems can record changes from inside each() and parallelEach().
+             * @note The systems of a parallel stage each get their own buffer instead, played back in the order the
+             * systems were added whatever thread ran them, see tick().
+             * @warning Other threads must not record commands.
+             */
+            CommandBuffer &commands()
+            {
+                CommandBuffer *buffer = _stageBuffer();
+
+                return buffer ? *buffer : _commandBuffers[ThreadPool::getThreadIndex()];
+            }
+
+            /**
+             * @brief Apply the commands recorded since the last sync point, in thread then system order.
+             *
+             * @note Called by tick() before each stage of systems and each system running last, commands recorded
+             * during the playback (by the subscribers of OnEntityCreated for instance) are applied too.
+             * @warning Must not be called while iterating over entities.
+             */
+            void playbackCommands()
+            {
+                for (CommandBuffer &buffer : _commandBuffers) {
+                    if (!buffer.empty()) _playback(buffer);
+                }
+                for (CommandBuffer &buffer : _stageBuffers) {
+                    if (!buffer.empty()) _playback(buffer);
+                }
+            }
+
+            /*================//
+            //  Change Ticks  //
+            //================*/
+
+            /**
+             * @brief Get the tick the components written now are stamped with.
+             *
+             * @return std::size_t The current change tick of the world.
+             */
+            std::size_t getChangeTick() const
+            {
+                return _storage->getChangeTick();
+            }
+
+            /**
+             * @brief Start a new change tick, for a consumer of the component changes.
+             *
+             * @return std::size_t The tick that just ended, to keep and pass to BaseComponent::hasChangedSince() on
+             * the next run of the consumer.
+             */
+            std::size_t markChangeTick()
+            {
+                return _storage->markChangeTick();
+            }
+
+            /**
+             * @brief Get the last tick a component of a type was written.
+             *
+             * @tparam T The component type.
+             * @return std::size_t The tick, 0 if no component of this type was ever written.
+             */
+            template <typename T> std::size_t getTypeChangeTick() const
+            {
+                return _storage->getTypeChangeTick(ECS_TYPEID(T));
+            }
+
+            /**
+             * @brief Call a function on every entity that got a component written after a tick.
+             *
+             * @param sinceTick The tick returned by the last call of the consumer to markChangeTick(), 0 to get every
+             * entity with components.
+             * @param func The function called with a pointer to each changed entity, once per entity.
+             * @note Only reads the change log from the first entry after sinceTick, so the cost grows with the
+             * number of changes and not with the number of entities.
+             */
+            template <typename Func> void eachChangedEntity(std::size_t sinceTick, Func &&func)
+            {
+                std::vector<BaseStorage::Change> &changes = _storage->getChanges();
+                std::size_t                       count   = changes.size();
+                auto byTick = [](std::size_t tick, const BaseStorage::Change &change) { return tick < change.tick; };
+                auto first  = std::upper_bound(changes.begin(), changes.end(), sinceTick, byTick);
+
+                for (std::size_t i = first - changes.begin(); i < count; i++) {
+                    Entity *entity = _getChangedEntity(changes[i]);
+                    if (entity) func(entity);
+                }
+            }
+
             /**
              * @brief Tick the world.
              * @note This function will call the tick function of all the systems in the world.
+             * @note The systems are grouped in stages, in the order they were added: a system joins the stage after
+             * the last one holding a system it conflicts with (see BaseSystem::conflictsWith()). The systems of a
+             * stage run at the same time on the shared ThreadPool, the stages run one after the other, so conflicting
+             * systems always run in the order they were added. Systems declaring nothing get a stage of their own.
+             * @note The recorded commands are played back before each stage and the queued events are flushed at the
+             * start of the tick and after each stage, see queueEvent().
+             * @note The systems calling BaseSystem::runsLast() (the Renderer) run once afterwards, on this thread.
              * @warning This function should only be called by the Engine.
              * @see Engine::EngineClass
              * @see ECS::BaseSystem
              */
             void tick()
             {
-                BaseSystem *renderer = nullptr;
-
+                if (_scheduleChanged) _buildSchedule();
+                flushEvents();
                 for (int i = 0; i < Engine::EngineClass::getEngine().getPlayersAmount(); i++) {
                     Engine::EngineClass::getEngine().setCurrentPlayer(i);
-                    for (auto &system : _systems) {
-                        if (system.first == "Renderer") {
-                            renderer = system.second.get();
-                            continue;
-                        }
-                        if (system.second) system.second->tick();
+                    for (const std::vector<BaseSystem *> &stage : _stages) {
+                        playbackCommands();
+                        _runStage(stage);
+                        flushEvents();
                     }
                 }
                 Engine::EngineClass::getEngine().setCurrentPlayer(Engine::EngineClass::getEngine().getOwnPlayer());
-                if (renderer != nullptr) renderer->tick();
+                for (BaseSystem *system : _lastSystems) {
+                    playbackCommands();
+                    system->tick();
+                }
+                _compactChanges();
+            }
+
+            /**
+             * @brief Get the stages the systems run in, see tick().
+             *
+             * @return const std::vector<std::vector<BaseSystem *>> & The stages in running order, without the systems
+             * running last. Up to date once the world ticked after the last addSystem().
+             */
+            const std::vector<std::vector<BaseSystem *>> &getStages() const
+            {
+                return _stages;
+            }
+
+            /*=====================//
+            //  Memory Statistics  //
+            //=====================*/
+
+            /**
+             * @brief Get the memory used by the entities and the components of the world.
+             *
+             * @return MemoryStats The live count, bytes, allocation count and peak of each component type, and the
+             * totals of the world. Print them with MemoryStats::dump().
+             * @note The entity bytes cover the entity table and each entity with its table of components.
+             */
+            MemoryStats memoryStats() const
+            {
+                MemoryStats stats;
+
+                stats.components  = _storage->getMemoryStats();
+                stats.entityBytes = _entities.capacity() * sizeof(EntitySlot);
+                for (type_t type = 0; type < ECS_MAX_COMPONENTS; type++) {
+                    stats.components[type].componentType = MemoryStats::getComponentType(type);
+                    stats.componentBytes += stats.components[type].bytes;
+                }
+                for (const EntitySlot &slot : _entities) {
+                    if (!slot.entity) continue;
+                    stats.entities++;
+                    stats.entityBytes += sizeof(Entity);
+                    stats.entityBytes += slot.entity->_components.capacity() * sizeof(std::unique_ptr<BaseComponent>);
+                }
+                stats.totalBytes = stats.entityBytes + stats.componentBytes;
+                return stats;
             }
 
             /*===================//
@@ -439,6 +915,7 @@ namespace ECS
              *
              * @return std::unordered_map<std::string, std::unique_ptr<BaseSystem>> A reference to Systems
              * unordered_map.
+             * @warning Add systems with addSystem() only, the schedule does not see the systems added here.
              */
             std::unordered_map<std::string, std::unique_ptr<BaseSystem>> &getSystems()
             {
@@ -446,18 +923,17 @@ namespace ECS
             }
 
             /**
-             * @brief Get the entities of the world.
+             * @brief Get the component storage backend of the world.
              *
-             * @return std::unordered_map<std::string, std::unique_ptr<BaseSystem>> A reference to Entities
-             * unordered_map.
+             * @return StorageType
              */
-            std::unordered_map<id_t, std::unique_ptr<Entity>> &getEntities()
+            StorageType getStorageType() const
             {
-                return _entities;
+                return _storageType;
             }
 
             /**
-             * @brief Get the entities to delete of the world.
+             * @brief Get the entities destroyed by removeEntity() since the list was last cleared.
              *
              * @return std::vector<ECS::id_t> &
              */
@@ -467,13 +943,18 @@ namespace ECS
             }
 
             /**
-             * @brief Get the subscribers of the world.
+             * @brief Get the channel of an event type, created on first use.
              *
-             * @return std::unordered_map<type_t, std::unordered_map<id_t, BaseEventSubscriber *>> &
+             * @tparam T The type of the event.
+             * @return EventChannel<T> & The subscribers of the event type.
              */
-            std::unordered_map<type_t, std::unordered_map<id_t, BaseEventSubscriber *>> &getSubscribers()
+            template <typename T> EventChannel<T> &getChannel()
             {
-                return _subscribers;
+                type_t type = ECS_EVENTID(T);
+
+                if (type >= _channels.size()) _channels.resize(type + 1);
+                if (!_channels[type]) _channels[type] = std::make_unique<EventChannel<T>>();
+                return static_cast<EventChannel<T> &>(*_channels[type]);
             }
 
         private:
@@ -482,42 +963,243 @@ namespace ECS
             //====================*/
 
             /**
-             * @brief Helper function to call a function on an entity with a single component type.
+             * @brief Store an entity in the slot of its id and notify the storage and the subscribers.
              *
-             * @tparam T The component type.
-             * @param entity Pointer to the entity.
-             * @param func The function to be applied to the entity and its component.
+             * @param id The unique identifier of the entity, its slot must be empty.
+             * @param entity The entity to store.
+             * @return id_t The unique identifier of the entity.
+             */
+            id_t _emplaceEntity(id_t id, std::unique_ptr<Entity> entity)
+            {
+                Events::OnEntityCreated event{entity.get()};
+
+                entity->setId(id);
+                _storage->insert(entity.get());
+                entity->trackComponents(true);
+                entity->getComponents(true);
+                _entities[Utils::getEntityIndex(id)].entity = std::move(entity);
+                broadcastEvent<Events::OnEntityCreated>(event);
+                return id;
+            }
+
+            /**
+             * @brief Get the entity of an entry of the change log.
+             *
+             * @param change The entry.
+             * @return Entity * The entity, nullptr if it was destroyed or if a later entry of the log holds it.
+             */
+            Entity *_getChangedEntity(const BaseStorage::Change &change)
+            {
+                if (!entityExists(change.entity)) return nullptr;
+
+                Entity *entity = _entities[Utils::getEntityIndex(change.entity)].entity.get();
+
+                return entity->_changeTick.load(std::memory_order_relaxed) == change.tick ? entity : nullptr;
+            }
+
+            /**
+             * @brief Drop the entries of the change log of destroyed entities and the ones superseded by a later entry.
+             *
+             * @note Only done once the log is twice as long as the entity table, the kept entries stay sorted by tick
+             * so the consumers still get every change.
              */
-            template <typename T>
-            void _eachHelper(Entity *entity, std::function<void(Entity *, ComponentHandle<T>)> func)
+            void _compactChanges()
             {
-                func(&entity, entity->getComponent<T>());
+                std::vector<BaseStorage::Change> &changes = _storage->getChanges();
+
+                if (changes.size() <= 2 * _entities.size()) return;
+                changes.erase(std::remove_if(changes.begin(), changes.end(),
+                                             [this](const BaseStorage::Change &change) {
+                                                 return _getChangedEntity(change) == nullptr;
+                                             }),
+                              changes.end());
             }
 
             /**
-             * @brief Recursive helper function to call a function on an entity with multiple component types.
+             * @brief Add the children of an entity, and their own children, to a list.
              *
-             * @tparam T The current component type being processed.
-             * @tparam V The next component type to be processed.
-             * @tparam Types Remaining component types to be processed.
-             * @param entity Pointer to the entity.
-             * @param func The function to be applied to the entity and its component.
-             * @note This function recursively iterates through the component types.
+             * @param id The unique identifier of the entity, it must exist.
+             * @param ids The list to fill.
              */
-            template <typename T, typename V, typename... Types>
-            void _eachHelper(Entity *entity, std::function<void(Entity *, ComponentHandle<T>)> func)
+            void _collectDescendants(id_t id, std::vector<id_t> &ids) const
             {
-                entity->has<T>() ? _eachHelper<T>(entity, func) : nullptr;
-                _eachHelper<V, Types...>(entity, func);
+                for (id_t child : _entities[Utils::getEntityIndex(id)].children) {
+                    ids.push_back(child);
+                    _collectDescendants(child, ids);
+                }
+            }
+
+            /**
+             * @brief Drop the systems, the queries and the storage without updating them entity by entity.
+             */
+            void _dropStorage()
+            {
+                _stages.clear();
+                _lastSystems.clear();
+                _systemsOrder.clear();
+                _systems.clear();
+                for (EntitySlot &slot : _entities) {
+                    if (slot.entity) slot.entity->_storage = nullptr;
+                }
+                _queries.clear();
+                _storage.reset();
+            }
+
+            /**
+             * @brief Take ownership of a system and schedule it at the next tick.
+             *
+             * @param name The name of the system, ignored if a system already has it.
+             * @param system The system.
+             */
+            void _addSystem(std::string name, std::unique_ptr<BaseSystem> system)
+            {
+                auto [entry, added] = _systems.emplace(std::move(name), std::move(system));
+
+                if (!added) return;
+                _systemsOrder.push_back(entry->second.get());
+                _scheduleChanged = true;
+            }
+
+            /**
+             * @brief Group the systems in stages, see tick().
+             */
+            void _buildSchedule()
+            {
+                std::size_t width = 0;
+
+                _stages.clear();
+                _lastSystems.clear();
+                for (BaseSystem *system : _systemsOrder) {
+                    std::size_t stage     = _stages.size();
+                    auto        conflicts = [system](BaseSystem *other) { return system->conflictsWith(*other); };
+
+                    if (system->isLast()) {
+                        _lastSystems.push_back(system);
+                        continue;
+                    }
+                    while (stage > 0 && std::none_of(_stages[stage - 1].begin(), _stages[stage - 1].end(), conflicts))
+                        stage--;
+                    if (stage == _stages.size()) _stages.emplace_back();
+                    _stages[stage].push_back(system);
+                    width = std::max(width, _stages[stage].size());
+                }
+                if (_stageBuffers.size() < width) _stageBuffers = std::vector<CommandBuffer>(width);
+                _scheduleChanged = false;
+            }
+
+            /**
+             * @brief Tick the systems of a stage, on the shared ThreadPool if there are several.
+             *
+             * @param stage The systems of the stage.
+             * @note The storage stays locked during the whole stage, so the iterations of the systems can end in any
+             * order.
+             */
+            void _runStage(const std::vector<BaseSystem *> &stage)
+            {
+                if (stage.size() == 1) return stage.front()->tick();
+
+                BaseStorage::IterationLock lock(*_storage);
+
+                ThreadPool::getThreadPool().run(stage.size(), [this, &stage](std::size_t index) {
+                    _stageBuffer() = &_stageBuffers[index];
+                    try {
+                        stage[index]->tick();
+                    } catch (...) {
+                        _stageBuffer() = nullptr;
+                        throw;
+                    }
+                    _stageBuffer() = nullptr;
+                });
+            }
+
+            /**
+             * @brief Get the command buffer of the system of a parallel stage the calling thread runs.
+             *
+             * @return CommandBuffer *& The buffer, nullptr outside of a parallel stage.
+             */
+            static CommandBuffer *&_stageBuffer()
+            {
+                static thread_local CommandBuffer *buffer = nullptr;
+
+                return buffer;
+            }
+
+            /**
+             * @brief Remove an entity from the roots of the hierarchies, if it is one.
+             *
+             * @param id The unique identifier of the entity.
+             */
+            void _removeHierarchyRoot(id_t id)
+            {
+                auto root = std::find(_hierarchyRoots.begin(), _hierarchyRoots.end(), id);
+
+                if (root != _hierarchyRoots.end()) _hierarchyRoots.erase(root);
+            }
+
+            /**
+             * @brief Apply and drop the commands of a buffer.
+             *
+             * @param buffer The buffer to play back.
+             */
+            void _playback(CommandBuffer &buffer)
+            {
+                id_t created = 0;
+
+                for (std::size_t i = 0; i < buffer._commands.size(); i++) {
+                    CommandBuffer::Command command = buffer._commands[i];
+                    id_t                   id      = command.entity;
+
+                    if (id == CommandBuffer::createdEntity) id = created;
+                    buffer._commands[i].component = nullptr;
+                    if (command.type == CommandBuffer::CommandType::CreateEntity) {
+                        created = addEntity();
+                    } else if (!entityExists(id)) {
+                        delete command.component;
+                    } else if (command.type == CommandBuffer::CommandType::DestroyEntity) {
+                        _collectDescendants(id, _entitiesToDelete);
+                        _entitiesToDelete.push_back(id);
+                        destroyEntity(id);
+                    } else {
+                        command.apply(getMutEntity(id), command);
+                    }
+                }
+                buffer._commands.clear();
             }
 
             /*==============//
             //  Attributes  //
             //==============*/
 
-            std::unordered_map<id_t, std::unique_ptr<Entity>>                           _entities;
-            std::unordered_map<type_t, std::unordered_map<id_t, BaseEventSubscriber *>> _subscribers;
+            /**
+             * @brief Slot of the entity table, the generation counts the entities destroyed in this slot.
+             */
+            struct EntitySlot {
+                    std::unique_ptr<Entity> entity;
+                    std::size_t             generation = 0;
+                    id_t                    parent     = noParent;
+                    std::vector<id_t>       children;
+                    bool                    mirrored   = false; // Created by addEntity(id_t) for a remote entity
+            };
+
+            StorageType                                                                 _storageType;
+            std::unique_ptr<BaseStorage>                                                _storage;
+            std::vector<std::unique_ptr<BaseQuery>>                                     _queries;
+            std::vector<EntitySlot>                                                     _entities;
+            std::vector<std::size_t>                                                    _freeSlots;
+            std::vector<id_t>                                                           _hierarchyRoots;
+            std::vector<CommandBuffer>                                                  _commandBuffers;
+            std::vector<std::shared_ptr<void>>                                          _resources;
+            std::unordered_map<std::string, Prefab>                                     _prefabs;
+            std::vector<std::unique_ptr<BaseEventChannel>>                              _channels;
+            std::vector<BaseEventChannel *>                                             _pendingChannels;
+            std::vector<BaseEventChannel *>                                             _flushedChannels;
             std::unordered_map<std::string, std::unique_ptr<BaseSystem>>                _systems;
+            std::vector<BaseSystem *>                                                   _systemsOrder;
+            std::vector<std::vector<BaseSystem *>>                                      _stages;
+            std::vector<BaseSystem *>                                                   _lastSystems;
+            std::vector<CommandBuffer>                                                  _stageBuffers;
+            bool                                                                        _scheduleChanged;
+            std::mutex                                                                  _queriesMutex;
             Clock                                                                       _clock;
             Engine::EngineClass                                                        &_engine;
             std::vector<ECS::id_t>                                                      _entitiesToDelete;
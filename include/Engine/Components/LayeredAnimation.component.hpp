@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <memory>
 #include <vector>
 
 #include "ECS/Components.hpp"
@@ -20,6 +21,15 @@ namespace Engine::Components
             LayeredAnimationComponent()           = default;
             ~LayeredAnimationComponent() override = default;
 
+            /**
+             * @brief Copy the component and each of its layers, so copies do not share their layers (see ECS::Prefab).
+             */
+            LayeredAnimationComponent(const LayeredAnimationComponent &other) : animation(), layers(other.layers)
+            {
+                for (const auto &layer : other.animation)
+                    animation.push_back(std::make_shared<AnimationComponent>(*layer));
+            }
+
             /**
              * @brief Construct a new Layered Animation Component object
              *
@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <memory>
 #include <vector>
 
 #include "ECS/Components.hpp"
@@ -30,6 +31,15 @@ namespace Engine::Components
             {
                 layers = renderable.size();
             }
+            /**
+             * @brief Copy the component and each of its layers, so copies do not share their layers (see ECS::Prefab).
+             */
+            LayeredRenderableComponent(const LayeredRenderableComponent &other)
+                : renderable(), layers(other.layers), priority(other.priority), isDisplayed(other.isDisplayed)
+            {
+                for (const auto &layer : other.renderable)
+                    renderable.push_back(std::make_shared<RenderableComponent>(*layer));
+            }
             ~LayeredRenderableComponent() override = default;
 
             std::vector<char> serialize() override
@@ -10,6 +10,7 @@
 #include <SFML/Graphics/RenderTexture.hpp>
 #include <SFML/System/Vector2.hpp>
 #include <iostream>
+#include <memory>
 #include <sstream>
 #include <tuple>
 #include <vector>
@@ -50,14 +51,19 @@ namespace Engine::Components
                 setTexture();
             }
 
+            /**
+             * @brief Load the texture at path and set up the sprite.
+             * @note The texture is shared with the copies of the component (see ECS::Prefab), they do not reload it.
+             */
             void setTexture()
             {
-                if (!texture.loadFromFile(path)) throw std::runtime_error("Cannot load texture " + path);
-                sprite = sf::Sprite(texture);
+                texture = std::make_shared<sf::Texture>();
+                if (!texture->loadFromFile(path)) throw std::runtime_error("Cannot load texture " + path);
+                sprite = sf::Sprite(*texture);
                 sprite.setScale(scale.x, scale.y);
                 sprite.setPosition(position.x, position.y);
                 sprite.setRotation(rotation);
-                size = {texture.getSize().x, texture.getSize().y};
+                size = {texture->getSize().x, texture->getSize().y};
                 if (setOrigin) sprite.setOrigin(size.x / 2, size.y / 2);
             }
 
@@ -162,17 +168,17 @@ namespace Engine::Components
                 return ComponentType::RenderableComponent;
             }
 
-            sf::Texture              texture;
-            sf::Sprite               sprite;
-            sf::Vector2<std::size_t> size;
-            sf::Vector2<float>       position;
-            int                      priority;
-            float                    rotation;
-            sf::Vector2<float>       scale;
-            sf::Vector2<float>       savedScale;
-            bool                     isDisplayed;
-            std::string              path;
-            bool                     setOrigin = false;
-            std::string              name;
+            std::shared_ptr<sf::Texture> texture;
+            sf::Sprite                   sprite;
+            sf::Vector2<std::size_t>     size;
+            sf::Vector2<float>           position;
+            int                          priority;
+            float                        rotation;
+            sf::Vector2<float>           scale;
+            sf::Vector2<float>           savedScale;
+            bool                         isDisplayed;
+            std::string                  path;
+            bool                         setOrigin = false;
+            std::string                  name;
     };
 } // namespace Engine::Components
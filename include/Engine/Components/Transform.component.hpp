@@ -0,0 +1,65 @@
+/*
+** EPITECH PROJECT, 2024
+** B-CPP-500-LIL-5-2-rtype-ewen.sellitto
+** File description:
+** Transform.component.hpp
+*/
+
+#pragma once
+
+#include <sstream>
+#include <vector>
+
+#include "ECS/Components.hpp"
+#include "public/ComponentsType.hpp"
+
+namespace Engine::Components
+{
+    /**
+     * @brief Position of an entity relative to its parent (see ECS::World::setParent()).
+     *
+     * @note The Transform system sets the PositionComponent of the entity to the position of its parent plus this
+     * offset, move the entity by changing the offset.
+     */
+    struct TransformComponent : public ECS::BaseComponent {
+        public:
+            TransformComponent() : x(0), y(0) {}
+            explicit TransformComponent(int x, int y) : x(x), y(y) {}
+            ~TransformComponent() override = default;
+
+            std::vector<char> serialize() override
+            {
+                std::ostringstream oss(std::ios::binary);
+                oss.write(reinterpret_cast<const char *>(&x), sizeof(x));
+                oss.write(reinterpret_cast<const char *>(&y), sizeof(y));
+
+                const std::string &str = oss.str();
+                return {str.begin(), str.end()};
+            }
+
+            ECS::BaseComponent *deserialize(std::vector<char> vec, ECS::BaseComponent *component) override
+            {
+                TransformComponent *transformComponent;
+                if (component == nullptr) {
+                    transformComponent = new TransformComponent();
+                } else {
+                    transformComponent = dynamic_cast<TransformComponent *>(component);
+                    if (transformComponent == nullptr) return nullptr;
+                }
+
+                std::istringstream iss(std::string(vec.begin(), vec.end()), std::ios::binary);
+                iss.read(reinterpret_cast<char *>(&transformComponent->x), sizeof(transformComponent->x));
+                iss.read(reinterpret_cast<char *>(&transformComponent->y), sizeof(transformComponent->y));
+
+                return transformComponent;
+            }
+
+            ComponentType getType() override
+            {
+                return ComponentType::TransformComponent;
+            }
+
+            int x;
+            int y;
+    };
+} // namespace Engine::Components
@@ -15,6 +15,7 @@
 
 #include "ECS/Entity.hpp"
 #include "Server/Network.hpp"
+#include "Utils/InputState.hpp"
 
 namespace ECS
 {
@@ -45,6 +46,14 @@ namespace ECS
 #define ADD_RENDERER_SYSTEM
 #endif
 
+#ifndef DONT_ADD_TRANSFORM_SYSTEM
+#define ADD_TRANSFORM_SYSTEM
+#endif
+
+#ifndef WORLD_TEARDOWN_BUDGET // Number of entities of a previous world destroyed per frame after a switch
+#define WORLD_TEARDOWN_BUDGET 1024
+#endif // !WORLD_TEARDOWN_BUDGET
+
 #define WINDOW Engine::EngineClass::getEngine().window
 #define WORLD Engine::EngineClass::getEngine().world()
 #define NETWORK Engine::EngineClass::getEngine().network()
@@ -96,6 +105,8 @@ namespace Engine
             int getPlayersAmount() const;
             int getOwnPlayer() const;
 
+            const InputState &input() const;
+
             /*===================//
             //  Worlds Handling  //
             //===================*/
@@ -131,8 +142,7 @@ namespace Engine
             // Network Handling //
             //==================*/
 
-            void componentsUpdater(std::tuple<ECS::id_t, std::vector<ComponentType>,
-                                              std::vector<std::pair<ECS::BaseComponent *, ComponentType>>> &tuple);
+            void componentsUpdater(ECS::components_update_t &tuple);
 
             /*=====================//
             //  Public Attributes  //
@@ -177,6 +187,8 @@ namespace Engine
             int                                                               _currentPlayer;
             int                                                               _ownPlayer;
             std::unordered_map<ECS::id_t, std::unique_ptr<ECS::GlobalEntity>> _global_entities;
+            InputState                                                        _input;
+            std::vector<sf::Event>                                            _frameEvents;
 
             /*===================//
             //  Private Methods  //
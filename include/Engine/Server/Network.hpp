@@ -10,8 +10,12 @@
 #include <SFML/Network.hpp>
 #include <SFML/Window/Event.hpp>
 #include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 #include "ECS/Components.hpp"
+#include "ECS/MPSCQueue.hpp"
 #include "Engine/Server/WaitingRoom.hpp"
 #include "public/AvailableComponents.hpp"
 
@@ -54,6 +58,15 @@ struct IpAddressHash {
 };
 namespace ECS
 {
+    class World;
+
+    /**
+     * @brief Update of an entity received from the server: its id, the components to remove and the components to
+     * add or replace. No component at all means the entity is destroyed.
+     */
+    typedef std::tuple<ECS::id_t, std::vector<ComponentType>, std::vector<std::pair<BaseComponent *, ComponentType>>>
+        components_update_t;
+
     class Network
     {
         public:
@@ -80,16 +93,10 @@ namespace ECS
             void sendRemovedEntitiesToClients(std::vector<ECS::id_t> &removedEntities);
             void sendEventsToServer();
 
-            int getNbEntitiesModified();
-            int getNbEntitiesWithDeletedComponents();
-
             void addSerializedEventToPacket(sf::Packet &packet, sf::Event event);
             void addSerializedComponentToPacket(sf::Packet &packet, ECS::BaseComponent *component);
-            void addSerializedEntityToPacket(sf::Packet                                                     &packet,
-                                             const std::pair<const ECS::id_t, std::unique_ptr<ECS::Entity>> &pair);
-            void
-                 addSerializedDeletedEntityToPacket(sf::Packet                                                     &packet,
-                                                    const std::pair<const ECS::id_t, std::unique_ptr<ECS::Entity>> &pair);
+            bool addSerializedEntityToPacket(sf::Packet &packet, ECS::Entity *entity, std::size_t sinceTick);
+            bool addSerializedDeletedEntityToPacket(sf::Packet &packet, ECS::Entity *entity);
             void sendPacketTypeToServer(PacketType packetType, const sf::IpAddress &recipient, unsigned short port);
             void sendPacketToServer(sf::Packet &packet);
 
@@ -124,7 +131,12 @@ namespace ECS
             {
                 return _port;
             }
-            std::vector<sf::Event> getEvents() const
+            /**
+             * @brief Get the inputs to send to the server.
+             *
+             * @note Filled by the game loop, popped by the network thread.
+             */
+            MPSCQueue<sf::Event> &getEvents()
             {
                 return clientEvents;
             }
@@ -139,7 +151,12 @@ namespace ECS
                 return gameHasStarted;
             }
 
-            std::map<int, std::vector<sf::Event>> &getServerEvents()
+            /**
+             * @brief Get the inputs received from the clients, each one with the number of its player.
+             *
+             * @note Filled by the network thread, popped by the game loop.
+             */
+            MPSCQueue<std::pair<int, sf::Event>> &getServerEvents()
             {
                 return serverEvents;
             }
@@ -154,9 +171,12 @@ namespace ECS
                 return needToReset;
             }
 
-            std::vector<std::tuple<ECS::id_t, std::vector<ComponentType>,
-                                   std::vector<std::pair<BaseComponent *, ComponentType>>>> &
-            getComponentsToUpdate()
+            /**
+             * @brief Get the entity updates received from the server.
+             *
+             * @note Filled by the network thread, popped by the game loop.
+             */
+            MPSCQueue<components_update_t> &getComponentsToUpdate()
             {
                 return componentsToUpdate;
             }
@@ -182,11 +202,19 @@ namespace ECS
             // =================== EVENTS HANDLING =====================
             // =========================================================
 
+            /**
+             * @brief Queue an input for the next packet sent to the server, from the game loop.
+             *
+             * @param event The input, already coalesced by the engine.
+             */
             void addEvent(sf::Event event)
             {
-                clientEvents.push_back(event);
+                clientEvents.push(event);
             }
 
+            /**
+             * @brief Drop the inputs not sent yet, from the network thread or once it is stopped.
+             */
             void clearEvents()
             {
                 clientEvents.clear();
@@ -202,16 +230,17 @@ namespace ECS
 
             void resetServer()
             {
+                stop();
                 needToReset    = false;
                 isServer       = false;
                 gameHasStarted = false;
                 isReadyToStart = false;
                 serverAddress  = sf::IpAddress::None;
                 serverHost     = std::make_pair(sf::IpAddress::None, 0);
+                clientEvents.clear();
                 serverEvents.clear();
                 componentsToUpdate.clear();
                 waitingRoom.clear();
-                stop();
             }
 
             bool getIsReadyToStart() const
@@ -272,11 +301,11 @@ namespace ECS
             bool                                     gameHasStarted = false;
             bool                                     isReadyToStart = false;
             ComponentsConvertor                      componentsConvertor;
-            std::vector<sf::Event>                   clientEvents;
-            std::map<int, std::vector<sf::Event>>    serverEvents;
+            MPSCQueue<sf::Event>                     clientEvents;
+            MPSCQueue<std::pair<int, sf::Event>>     serverEvents;
             std::pair<sf::IpAddress, unsigned short> serverHost;
-            std::vector<std::tuple<ECS::id_t, std::vector<ComponentType>,
-                                   std::vector<std::pair<BaseComponent *, ComponentType>>>>
-                componentsToUpdate;
+            ECS::World                              *replicatedWorld = nullptr;
+            std::size_t                              replicatedTick  = 0;
+            MPSCQueue<components_update_t>           componentsToUpdate;
     };
 } // namespace ECS
@@ -8,6 +8,7 @@
 #pragma once
 
 #include <SFML/Network.hpp>
+#include <memory>
 #include <vector>
 
 #include "Engine/Server/ClientInfo.hpp"
@@ -16,7 +17,7 @@ struct WaitingRoom {
 
         void addPlayer(const sf::IpAddress &player, unsigned short port, bool isServer = false)
         {
-            players.push_back(new ClientInfo(player, port, ClientState::InLobby, isServer));
+            players.push_back(std::make_unique<ClientInfo>(player, port, ClientState::InLobby, isServer));
         }
 
         void clear()
@@ -27,7 +28,11 @@ struct WaitingRoom {
 
         std::vector<ClientInfo *> getPlayers() const
         {
-            return players;
+            std::vector<ClientInfo *> list;
+
+            for (const auto &player : players)
+                list.push_back(player.get());
+            return list;
         }
 
         bool isGameStarted() const
@@ -81,12 +86,7 @@ struct WaitingRoom {
             }
         }
 
-        std::vector<ClientInfo *> getPlayers()
-        {
-            return players;
-        }
-
     private:
-        std::vector<ClientInfo *> players;
-        bool                      isStarted = false;
+        std::vector<std::unique_ptr<ClientInfo>> players;
+        bool                                     isStarted = false;
 };
@@ -9,14 +9,30 @@
 
 #include "ECS/System.hpp"
 #include "ECS/World.hpp"
+#include "Engine/Components/Animation.component.hpp"
+#include "Engine/Components/LayeredAnimation.component.hpp"
+#include "Engine/Components/LayeredRenderable.component.hpp"
+#include "Engine/Components/Renderable.component.hpp"
 
 namespace Engine::System
 {
+    /**
+     * @class AnimationSystem
+     * @brief Moves the texture rectangle of the animated sprites to their current frame.
+     */
     class AnimationSystem : public ECS::BaseSystem
     {
         public:
-            AnimationSystem(ECS::World &world) : ECS::BaseSystem(world) {}
-            AnimationSystem(ECS::World &world, ECS::id_t ids...) : ECS::BaseSystem(world, ids) {}
+            AnimationSystem(ECS::World &world) : ECS::BaseSystem(world)
+            {
+                writes<Components::RenderableComponent, Components::AnimationComponent>();
+                writes<Components::LayeredRenderableComponent, Components::LayeredAnimationComponent>();
+            }
+            AnimationSystem(ECS::World &world, ECS::id_t ids...) : ECS::BaseSystem(world, ids)
+            {
+                writes<Components::RenderableComponent, Components::AnimationComponent>();
+                writes<Components::LayeredRenderableComponent, Components::LayeredAnimationComponent>();
+            }
             ~AnimationSystem() override = default;
 
             void configure(ECS::World &world) override;
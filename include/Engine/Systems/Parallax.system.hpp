@@ -9,13 +9,24 @@
 
 #include "ECS/System.hpp"
 #include "ECS/World.hpp"
+#include "Engine/Components/Parallax.component.hpp"
+#include "Engine/Components/Position.component.hpp"
+#include "Engine/Components/Renderable.component.hpp"
 
 namespace Engine::System
 {
+    /**
+     * @class ParallaxSystem
+     * @brief Scrolls the parallax layers and wraps them around once they left the screen.
+     */
     class ParallaxSystem : public ECS::BaseSystem
     {
         public:
-            ParallaxSystem(ECS::World &world) : ECS::BaseSystem(world) {}
+            ParallaxSystem(ECS::World &world) : ECS::BaseSystem(world)
+            {
+                reads<Components::ParallaxComponent, Components::RenderableComponent>();
+                writes<Components::PositionComponent>();
+            }
 
             void configure(ECS::World &world) override;
 
@@ -9,6 +9,7 @@
 
 #include <chrono>
 
+#include "ECS/SoABuffer.hpp"
 #include "ECS/System.hpp"
 #include "ECS/World.hpp"
 #include "Engine/Components/Collision.component.hpp"
@@ -24,8 +25,8 @@ namespace Engine::System
     class Physics : public ECS::BaseSystem
     {
         public:
-            Physics(ECS::World &world) : ECS::BaseSystem(world){};
-            Physics(ECS::World &world, ECS::id_t ids...) : ECS::BaseSystem(world, ids) {}
+            Physics(ECS::World &world) : ECS::BaseSystem(world), _moves(), _movingEntities(){};
+            Physics(ECS::World &world, ECS::id_t ids...) : ECS::BaseSystem(world, ids), _moves(), _movingEntities() {}
             ~Physics() override = default;
 
             void configure(ECS::World &world) override;
@@ -37,11 +38,21 @@ namespace Engine::System
             // move functions
             void moveTime(ECS::Entity *entity, ECS::ComponentHandle<Components::MovingComponent> handle);
 
-            // collision function
+            // collision function, queues a CollisionEvent per overlapping entity
             void collide(ECS::Entity *entity, int x, int y);
 
         private:
+            /**
+             * @brief Fields of the moves gathered by tick(), in the order of the SoABuffer template arguments.
+             */
+            enum MoveField { Elapsed, Duration, InitialX, InitialY, AmountX, AmountY, NewX, NewY, Ended };
+
+            void endMove(ECS::Entity *entity, sf::Vector2f newPosition, int endedMoveCounter);
+
             sf::FloatRect get_hitbox_with_rotation(ECS::ComponentHandle<Engine::Components::CollisionComponent> &hitbox,
                                                    int rotation, int x, int y);
+
+            ECS::SoABuffer<float, float, float, float, float, float, float, float, int> _moves;
+            std::vector<ECS::Entity *>                                                _movingEntities;
     };
 } // namespace Engine::System
@@ -15,8 +15,14 @@ namespace Engine::System
     class Renderer : public ECS::BaseSystem
     {
         public:
-            Renderer(ECS::World &world) : ECS::BaseSystem(world){};
-            Renderer(ECS::World &world, ECS::id_t ids...) : ECS::BaseSystem(world, ids) {}
+            Renderer(ECS::World &world) : ECS::BaseSystem(world)
+            {
+                runsLast();
+            }
+            Renderer(ECS::World &world, ECS::id_t ids...) : ECS::BaseSystem(world, ids)
+            {
+                runsLast();
+            }
             ~Renderer() override = default;
 
             void configure(ECS::World &world) override;
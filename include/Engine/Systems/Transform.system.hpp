@@ -0,0 +1,48 @@
+/*
+** EPITECH PROJECT, 2024
+** B-CPP-500-LIL-5-2-rtype-ewen.sellitto
+** File description:
+** Transform.system.hpp
+*/
+
+#pragma once
+
+#include "ECS/System.hpp"
+#include "ECS/World.hpp"
+#include "Engine/Components/Position.component.hpp"
+#include "Engine/Components/Transform.component.hpp"
+
+namespace Engine::System
+{
+    /**
+     * @class Transform
+     * @brief Moves the children of the world hierarchy with their parent.
+     *
+     * @note Walks each hierarchy from its root, the PositionComponent of a child caches its world position and is
+     * only written when it no longer matches the position of the parent plus the TransformComponent of the child.
+     */
+    class Transform : public ECS::BaseSystem
+    {
+        public:
+            Transform(ECS::World &world) : ECS::BaseSystem(world)
+            {
+                reads<Components::TransformComponent>();
+                writes<Components::PositionComponent>();
+            }
+            Transform(ECS::World &world, ECS::id_t ids...) : ECS::BaseSystem(world, ids)
+            {
+                reads<Components::TransformComponent>();
+                writes<Components::PositionComponent>();
+            }
+            ~Transform() override = default;
+
+            void configure(ECS::World &world) override;
+
+            void unconfigure() override;
+
+            void tick() override;
+
+        private:
+            void updateChildren(ECS::id_t parent, const Components::PositionComponent &parentPosition);
+    };
+} // namespace Engine::System
@@ -11,14 +11,25 @@
 
 #include "ECS/System.hpp"
 #include "ECS/World.hpp"
+#include "Engine/Components/WorldMoveProgress.component.hpp"
 
 namespace Engine::System
 {
+    /**
+     * @class WorldMoveSystem
+     * @brief Updates the progress of the world scrolling, kept in the WorldMoveProgressComponent of an entity.
+     */
     class WorldMoveSystem : public ECS::BaseSystem
     {
         public:
-            WorldMoveSystem(ECS::World &world) : ECS::BaseSystem(world){};
-            WorldMoveSystem(ECS::World &world, ECS::id_t ids...) : ECS::BaseSystem(world, ids) {}
+            WorldMoveSystem(ECS::World &world) : ECS::BaseSystem(world)
+            {
+                writes<Components::WorldMoveProgressComponent>();
+            }
+            WorldMoveSystem(ECS::World &world, ECS::id_t ids...) : ECS::BaseSystem(world, ids)
+            {
+                writes<Components::WorldMoveProgressComponent>();
+            }
             ~WorldMoveSystem() override = default;
 
             void configure(ECS::World &world) override;
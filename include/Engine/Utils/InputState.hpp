@@ -0,0 +1,143 @@
+/*
+** EPITECH PROJECT, 2024
+** B-CPP-500-LIL-5-2-rtype-ewen.sellitto
+** File description:
+** InputState.hpp
+*/
+
+#pragma once
+
+#include <SFML/System/Vector2.hpp>
+#include <SFML/Window/Event.hpp>
+#include <SFML/Window/Keyboard.hpp>
+#include <bitset>
+#include <cstddef>
+#include <vector>
+
+#ifndef KEEP_KEY_REPEAT // Key pressed events repeated by the OS while a key is held down are dropped, define
+#define DROP_KEY_REPEAT // KEEP_KEY_REPEAT to receive one KeyPressedEvent per frame while the key is held
+#endif                  // !KEEP_KEY_REPEAT
+
+namespace Engine
+{
+    /**
+     * @class InputState
+     * @brief State of the keyboard, the mouse and the window, built from the events polled each frame.
+     *
+     * @note coalesce() collapses the redundant events of a frame before they are broadcast and sent to the server:
+     * a key pressed again while it is down, all the mouse moves but the last and all the resizes but the last. The
+     * order of the other events is kept, a key released and pressed again in the same frame gives both events.
+     * @note Systems that only need the current state poll isKeyDown(), getMousePosition()... instead of subscribing to
+     * every event.
+     */
+    class InputState
+    {
+        public:
+            InputState(sf::Vector2u windowSize = {0, 0})
+                : _keysDown(), _keysPressed(), _mousePosition(0, 0), _windowSize(windowSize)
+            {
+            }
+
+            /**
+             * @brief Collapse the redundant events of a frame and update the state with them.
+             *
+             * @param events The events of the frame in polling order, only the events to process are left.
+             */
+            void coalesce(std::vector<sf::Event> &events)
+            {
+                std::size_t lastMouseMove = events.size();
+                std::size_t lastResize    = events.size();
+                std::size_t kept          = 0;
+
+                for (std::size_t i = 0; i < events.size(); i++) {
+                    if (events[i].type == sf::Event::MouseMoved) lastMouseMove = i;
+                    if (events[i].type == sf::Event::Resized) lastResize = i;
+                }
+                _keysPressed.reset();
+                for (std::size_t i = 0; i < events.size(); i++) {
+                    if (!update(events[i], i == lastMouseMove || i == lastResize)) continue;
+                    events[kept++] = events[i];
+                }
+                events.resize(kept);
+            }
+
+            /**
+             * @brief Check if a key is held down.
+             */
+            bool isKeyDown(sf::Keyboard::Key key) const
+            {
+                return isKnown(key) && _keysDown[key];
+            }
+
+            /**
+             * @brief Check if a key went down during the last frame.
+             */
+            bool isKeyPressed(sf::Keyboard::Key key) const
+            {
+                return isKnown(key) && _keysPressed[key];
+            }
+
+            sf::Vector2i getMousePosition() const
+            {
+                return _mousePosition;
+            }
+
+            sf::Vector2u getWindowSize() const
+            {
+                return _windowSize;
+            }
+
+        private:
+            static bool isKnown(sf::Keyboard::Key key)
+            {
+                return key >= 0 && key < sf::Keyboard::KeyCount;
+            }
+
+            /**
+             * @brief Apply an event to the state.
+             *
+             * @param event The event.
+             * @param last True if it is the last event of its type in the frame.
+             * @return bool False if the event is redundant and must be dropped.
+             */
+            bool update(const sf::Event &event, bool last)
+            {
+                switch (event.type) {
+                    case sf::Event::KeyPressed:
+                        if (!isKnown(event.key.code)) return true;
+#ifdef DROP_KEY_REPEAT
+                        if (_keysDown[event.key.code]) return false;
+#else
+                        if (_keysDown[event.key.code] && _keysPressed[event.key.code]) return false;
+#endif
+                        _keysDown.set(event.key.code);
+                        _keysPressed.set(event.key.code);
+                        return true;
+
+                    case sf::Event::KeyReleased:
+                        if (isKnown(event.key.code)) _keysDown.reset(event.key.code);
+                        return true;
+
+                    case sf::Event::LostFocus:
+                        _keysDown.reset();
+                        return true;
+
+                    case sf::Event::MouseMoved:
+                        if (last) _mousePosition = {event.mouseMove.x, event.mouseMove.y};
+                        return last;
+
+                    case sf::Event::Resized:
+                        if (last) _windowSize = {event.size.width, event.size.height};
+                        return last;
+
+                    default:
+                        return true;
+                }
+            }
+
+            std::bitset<sf::Keyboard::KeyCount> _keysDown;
+            std::bitset<sf::Keyboard::KeyCount> _keysPressed;
+            sf::Vector2i                        _mousePosition;
+            sf::Vector2u                        _windowSize;
+    };
+} // namespace Engine
@@ -8,6 +8,7 @@
 #pragma once
 
 #include <functional>
+#include <set>
 
 #include "ECS/Entity.hpp"
 #include "Engine/Components/Animation.component.hpp"
@@ -21,6 +22,7 @@
 #include "Engine/Components/Renderable.component.hpp"
 #include "Engine/Components/Score.component.hpp"
 #include "Engine/Components/Speed.component.hpp"
+#include "Engine/Components/Transform.component.hpp"
 #include "Engine/Components/View.component.hpp"
 #include "Engine/Components/WorldMoveProgress.component.hpp"
 #include "R-Type/Components/BaseBullet.component.hpp"
@@ -41,7 +43,7 @@ class ComponentsConvertor
     public:
         ComponentsConvertor()
         {
-            // add here your components.
+            // add here your components, and your tags with registerTag<T>().
             registerComponent<Engine::Components::AnimationComponent>(ComponentType::AnimationComponent);
             registerComponent<Engine::Components::CollisionComponent>(ComponentType::CollisionComponent);
             registerComponent<Engine::Components::ExcludeCollisionComponent>(ComponentType::ExcludeCollisionComponent);
@@ -60,6 +62,7 @@ class ComponentsConvertor
             registerComponent<Engine::Components::MissileComponent>(ComponentType::MissileComponent);
             registerComponent<Engine::Components::PlayerComponent>(ComponentType::PlayerComponent);
             registerComponent<Engine::Components::LinkComponent>(ComponentType::LinkComponent);
+            registerComponent<Engine::Components::TransformComponent>(ComponentType::TransformComponent);
             registerComponent<Rtype::Components::HealthComponent>(ComponentType::HealthComponent);
             registerComponent<Engine::Components::LayeredRenderableComponent>(
                 ComponentType::LayeredRenderableComponent);
@@ -91,6 +94,35 @@ class ComponentsConvertor
             };
         }
 
+        /**
+         * @brief Register a tag (see ECS::Tag), replicated as its type only.
+         *
+         * @tparam T The tag type, its componentType must not be NoneComponent.
+         */
+        template <typename T> void registerTag()
+        {
+            tags.insert(T::componentType);
+
+            destroyers[T::componentType] = [](ECS::Entity &entity) -> bool {
+                if (entity.has<T>()) {
+                    entity.removeTag<T>();
+                    return true;
+                }
+                return false;
+            };
+
+            adders[T::componentType] = [](ECS::Entity &entity, [[maybe_unused]] ECS::BaseComponent *comp) -> bool {
+                if (entity.has<T>()) return false;
+                entity.addTag<T>();
+                return true;
+            };
+        }
+
+        bool isTag(ComponentType type) const
+        {
+            return tags.find(type) != tags.end();
+        }
+
         ECS::BaseComponent *createComponent(ComponentType type)
         {
             auto it = components.find(type);
@@ -101,4 +133,5 @@ class ComponentsConvertor
         std::map<ComponentType, std::function<ECS::BaseComponent *()>>                              components;
         std::map<ComponentType, std::function<bool(ECS::Entity &)>>                                 destroyers;
         std::map<ComponentType, std::function<bool(ECS::Entity &entity, ECS::BaseComponent *comp)>> adders;
+        std::set<ComponentType>                                                                     tags;
 };
@@ -33,5 +33,6 @@ enum class ComponentType {
     isBoosterComponent,
     BoosterActiveComponent,
     LinkComponent,
+    TransformComponent,
     NoneComponent,
 };
@@ -18,6 +18,7 @@
 #include "Engine/Events/KeyReleased.event.hpp"
 #include "Engine/Events/Resize.event.hpp"
 #include "Engine/Systems/Renderer.system.hpp"
+#include "Engine/Systems/Transform.system.hpp"
 
 using namespace Engine;
 
@@ -65,7 +66,7 @@ EngineClass::EngineClass(const std::size_t window_size_x, const std::size_t wind
                               sf::Style::Close | sf::Style::Resize)),
       _running(false), _fullscreen(false), _worldsFactories(), _currentWorld(), _startWorld(std::move(start_world)),
       _windowSizeX(window_size_x), _windowSizeY(window_size_y), _network(), _playersAmount(1), _currentPlayer(0),
-      _ownPlayer(0), _global_entities()
+      _ownPlayer(0), _global_entities(), _input(sf::Vector2u(window_size_x, window_size_y)), _frameEvents()
 {
     window.setFramerateLimit(60);
 }
@@ -132,6 +133,16 @@ int EngineClass::getOwnPlayer() const
     return _ownPlayer;
 }
 
+/**
+ * @brief Get the state of the keyboard, the mouse and the window
+ * @return const InputState &
+ * @note Updated by handleEvents() at the start of each frame, before the world ticks
+ */
+const InputState &EngineClass::input() const
+{
+    return _input;
+}
+
 /*===================//
 //  Worlds Handling  //
 //===================*/
@@ -168,6 +179,7 @@ void EngineClass::addWorldFactory(const std::string &name, std::function<ECS::Wo
  * @return void
  * @note This function will throw an error if the world doesn't exist
  * @note You can define DONT_ADD_RENDERER_SYSTEM to not add the renderer system to the world automatically
+ * @note You can define DONT_ADD_TRANSFORM_SYSTEM to not add the transform system to the world automatically
  */
 void EngineClass::switchWorld(const std::string &name)
 {
@@ -179,6 +191,9 @@ void EngineClass::switchWorld(const std::string &name)
 #ifdef ADD_RENDERER_SYSTEM
     _currentWorld.second->addSystem<System::Renderer>("Renderer");
 #endif
+#ifdef ADD_TRANSFORM_SYSTEM
+    _currentWorld.second->addSystem<System::Transform>("Transform");
+#endif
 
     _pending_destroy.push_back(c);
 }
@@ -271,32 +286,39 @@ void EngineClass::processSwitchEvent(sf::Event event)
 
 void EngineClass::processClientsEvents()
 {
+    std::pair<int, sf::Event> event;
+
     if (!NETWORK.getGameHasStarted() || !NETWORK.getIsServer()) return;
-    for (auto &player : NETWORK.getWaitingRoom().getPlayers()) {
-        if (player->isServer) continue;
-        _currentPlayer = player->nbPlayer;
-        if (NETWORK.getServerEvents().find(player->nbPlayer) == NETWORK.getServerEvents().end()) continue;
-        for (const auto &event : NETWORK.getServerEvents()[player->nbPlayer]) {
-            processSwitchEvent(event);
-        }
-        NETWORK.getServerEvents()[player->nbPlayer].clear();
+    while (NETWORK.getServerEvents().pop(event)) {
+        _currentPlayer = event.first;
+        processSwitchEvent(event.second);
     }
     _currentPlayer = _ownPlayer;
 }
 
+/**
+ * @brief Poll the events of the window and process them
+ * @return void
+ * @note The events of the frame are coalesced first (see InputState): held keys, mouse moves and resizes do not flood
+ * the subscribers nor the packets sent to the server
+ */
 void EngineClass::handleEvents()
 {
     sf::Event event{};
 
-    while (window.pollEvent(event)) {
+    _frameEvents.clear();
+    while (window.pollEvent(event))
+        _frameEvents.push_back(event);
+    _input.coalesce(_frameEvents);
+    for (const sf::Event &frameEvent : _frameEvents) {
         if (NETWORK.getGameHasStarted() && !NETWORK.getIsServer() &&
-            (event.type == sf::Event::KeyPressed || event.type == sf::Event::KeyReleased
-             // event.type == sf::Event::MouseButtonPressed ||
-             // event.type == sf::Event::MouseButtonReleased ||
-             // event.type == sf::Event::MouseMoved ||))
+            (frameEvent.type == sf::Event::KeyPressed || frameEvent.type == sf::Event::KeyReleased
+             // frameEvent.type == sf::Event::MouseButtonPressed ||
+             // frameEvent.type == sf::Event::MouseButtonReleased ||
+             // frameEvent.type == sf::Event::MouseMoved ||))
              ))
-            NETWORK.addEvent(event);
-        processSwitchEvent(event);
+            NETWORK.addEvent(frameEvent);
+        processSwitchEvent(frameEvent);
     }
 }
 
@@ -327,15 +349,11 @@ void EngineClass::run()
             NETWORK.resetServer();
         }
 
-        for (auto &id : WORLD.getEntitesToDelete()) {
-            if (!WORLD.entityExists(id)) continue;
+        if (!NETWORK.getIsServer()) {
+            ECS::components_update_t update;
 
-            WORLD.getEntities().erase(id);
-        }
-        if (!NETWORK.getIsServer() && !NETWORK.getComponentsToUpdate().empty()) {
-            for (auto &tuple : NETWORK.getComponentsToUpdate())
-                componentsUpdater(tuple);
-            NETWORK.getComponentsToUpdate().clear();
+            while (NETWORK.getComponentsToUpdate().pop(update))
+                componentsUpdater(update);
         }
         if (NETWORK.getGameHasStarted() && NETWORK.getIsServer()) {
             NETWORK.sendUpdatedEntitiesToClients();
@@ -351,38 +369,46 @@ void EngineClass::run()
 // Network Handling //
 //==================*/
 
-void EngineClass::componentsUpdater(std::tuple<ECS::id_t, std::vector<ComponentType>,
-                                               std::vector<std::pair<ECS::BaseComponent *, ComponentType>>> &tuple)
-{
-    if (!WORLD.entityExists(std::get<0>(tuple))) {
-        if (std::get<1>(tuple).empty() && std::get<2>(tuple).empty()) return;
-        if (!std::get<2>(tuple).empty()) WORLD.addEntity(std::get<0>(tuple));
-        for (auto &comp : std::get<2>(tuple)) {
-            NETWORK.getComponentsConvertor().adders[comp.second](
-                Engine::EngineClass::getEngine().world().getMutEntity(std::get<0>(tuple)), comp.first);
-            if (comp.second == ComponentType::RenderableComponent)
-                dynamic_cast<Components::RenderableComponent *>(comp.first)->setTexture();
-        }
-    } else {
-        if (std::get<1>(tuple).empty() && std::get<2>(tuple).empty()) {
-            if (!WORLD.entityExists(std::get<0>(tuple))) return;
-
-            WORLD.getEntities().erase(std::get<0>(tuple));
-        }
-        if (!std::get<1>(tuple).empty()) {
-            for (auto &comp : std::get<1>(tuple)) {
-                NETWORK.getComponentsConvertor().destroyers[comp](
-                    Engine::EngineClass::getEngine().world().getMutEntity(std::get<0>(tuple)));
-            }
+/**
+ * @brief Apply an update of an entity received from the server
+ * @param tuple The id of the entity, the types removed from it and the components added to it
+ * @return void
+ * @note The network thread only decodes the packets, the entity is looked up and diffed here, on the game loop
+ * thread, so the world is never read while a system changes it
+ * @note A received component replaces the one of the same type, a received tag already set is kept
+ * @note The update of an id the world does not mirror (see ECS::World::addEntity(id_t)) is dropped
+ */
+void EngineClass::componentsUpdater(ECS::components_update_t &tuple)
+{
+    ECS::id_t                                                    id        = std::get<0>(tuple);
+    std::vector<ComponentType>                                  &removed   = std::get<1>(tuple);
+    std::vector<std::pair<ECS::BaseComponent *, ComponentType>> &added     = std::get<2>(tuple);
+    ComponentsConvertor                                         &convertor = NETWORK.getComponentsConvertor();
+
+    if (!WORLD.entityExists(id)) {
+        if (added.empty()) return;
+        if (WORLD.addEntity(id) == ECS::World::noEntity) {
+            for (auto &comp : added)
+                delete comp.first;
+            return;
         }
-        if (!std::get<2>(tuple).empty()) {
-            for (auto &comp : std::get<2>(tuple)) {
-                NETWORK.getComponentsConvertor().adders[comp.second](
-                    Engine::EngineClass::getEngine().world().getMutEntity(std::get<0>(tuple)), comp.first);
-                if (comp.second == ComponentType::RenderableComponent)
-                    dynamic_cast<Components::RenderableComponent *>(comp.first)->setTexture();
-            }
+    } else if (removed.empty() && added.empty()) {
+        WORLD.destroyEntity(id);
+        return;
+    }
+    ECS::Entity &entity = WORLD.getMutEntity(id);
+    for (ComponentType type : removed) {
+        auto destroyer = convertor.destroyers.find(type);
+        if (destroyer != convertor.destroyers.end()) destroyer->second(entity);
+    }
+    for (auto &comp : added) {
+        if (!convertor.isTag(comp.second)) convertor.destroyers[comp.second](entity);
+        if (!convertor.adders[comp.second](entity, comp.first)) {
+            delete comp.first;
+            continue;
         }
+        if (comp.second == ComponentType::RenderableComponent)
+            dynamic_cast<Components::RenderableComponent *>(comp.first)->setTexture();
     }
 }
 
@@ -413,16 +439,21 @@ void EngineClass::toggleFullscreen()
 //===================*/
 
 /**
- * @brief Destroy all the pending worlds
+ * @brief Destroy the pending worlds, a few entities per frame
  * @return void
- * @note This function will be called at the end of the run function
+ * @note This function will be called at the start of each frame of the run function
+ * @note Each call destroys up to WORLD_TEARDOWN_BUDGET entities of the oldest pending world, so switching away
+ * from a big world does not stall a single frame
  */
 void EngineClass::destroyPendingWorlds()
 {
-    if (_pending_destroy.empty()) return;
-    for (auto &world : _pending_destroy)
-        delete world.second;
-    _pending_destroy.clear();
+    while (!_pending_destroy.empty()) {
+        ECS::World *world = _pending_destroy.front().second;
+
+        if (world && !world->releaseEntities(WORLD_TEARDOWN_BUDGET)) return;
+        delete world;
+        _pending_destroy.erase(_pending_destroy.begin());
+    }
 }
 
 /*=========================//
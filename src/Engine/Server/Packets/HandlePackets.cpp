@@ -85,41 +85,6 @@ void ECS::Network::handleSwitchWorld(const sf::IpAddress &sender, unsigned short
     sendPacketToClient(responsePacket, sender, senderPort);
 }
 
-int ECS::Network::getNbEntitiesModified()
-{
-    int nbEntities = 0;
-    for (const auto &pair : Engine::EngineClass::getEngine().world().getEntities()) {
-        for (const auto &component : pair.second->getComponents()) {
-            if (component.second->getType() != ComponentType::NoneComponent && component.second->hasChanged()) {
-                nbEntities++;
-                break;
-            }
-        }
-    }
-
-    return nbEntities;
-}
-
-int ECS::Network::getNbEntitiesWithDeletedComponents()
-{
-    int nbEntities      = 0;
-    int nbCompsToDelete = 0;
-
-    for (const auto &pair : Engine::EngineClass::getEngine().world().getEntities()) {
-        nbCompsToDelete = static_cast<int>(pair.second->getComponentsToDelete().size());
-        for (const auto &component : pair.second->getComponents()) {
-            if (component.second->getType() != ComponentType::NoneComponent &&
-                std::find(pair.second->getComponentsToDelete().begin(), pair.second->getComponentsToDelete().end(),
-                          component.second->getType()) != pair.second->getComponentsToDelete().end()) {
-                nbCompsToDelete--;
-            }
-        }
-        if (nbCompsToDelete > 0) nbEntities++;
-    }
-
-    return nbEntities;
-}
-
 void ECS::Network::handleReceiveSwitchedWorld(const sf::IpAddress &sender, unsigned short clientPort)
 {
     for (const auto &player : waitingRoom.getPlayers()) {
@@ -142,13 +107,18 @@ void ECS::Network::handleReceiveSwitchedWorld(const sf::IpAddress &sender, unsig
     if (waitingRoom.allPlayersSwitchedWorld()) {
 
         sf::Packet packet;
+        sf::Packet entities;
+        int        nbEntities = 0;
         packet << static_cast<int>(PacketType::InitializeGame);
         packet << static_cast<int>(waitingRoom.getPlayers().size());
         switchToGame();
-        int nbEntities = getNbEntitiesModified();
+        WORLD.eachEntity([&](ECS::Entity *entity) {
+            if (addSerializedEntityToPacket(entities, entity, 0)) nbEntities++;
+        });
         packet << nbEntities;
-        for (const auto &pair : WORLD.getEntities())
-            addSerializedEntityToPacket(packet, pair);
+        packet.append(entities.getData(), entities.getDataSize());
+        replicatedWorld = &WORLD;
+        replicatedTick  = WORLD.markChangeTick();
         sendPacketToAllClients(packet);
     }
 }
@@ -195,6 +165,6 @@ void ECS::Network::handleKeyInputs(sf::Packet &packet, const sf::IpAddress &send
         sf::Event event    = deserializeEvent(packet);
         int       playerNb = findPlayerNb(sender, senderPort);
         if (playerNb == -1) continue;
-        serverEvents[playerNb].push_back(event);
+        serverEvents.push({playerNb, event});
     }
 }
@@ -36,50 +36,58 @@ void ECS::Network::sendRemovedEntitiesToClients(std::vector<ECS::id_t> &removedE
 
 void ECS::Network::sendUpdatedEntitiesToClients()
 {
-    sf::Packet packet;
-    int        nbEntities = 0;
+    sf::Packet  packet;
+    sf::Packet  entities;
+    int         nbEntities = 0;
+    ECS::World &world      = EngineClass::getEngine().world();
+    std::size_t sinceTick  = replicatedWorld == &world ? replicatedTick : 0;
     packet << static_cast<int>(PacketType::ClientUpdate);
     packet << static_cast<int>(UpdateType::AddComponents);
 
-    nbEntities = getNbEntitiesModified();
+    replicatedWorld = &world;
+    replicatedTick  = world.markChangeTick();
+    world.eachChangedEntity(sinceTick, [&](ECS::Entity *entity) {
+        if (addSerializedEntityToPacket(entities, entity, sinceTick)) nbEntities++;
+    });
     if (nbEntities == 0) return;
     packet << nbEntities;
-    for (const auto &pair : EngineClass::getEngine().world().getEntities()) {
-        addSerializedEntityToPacket(packet, pair);
-    }
+    packet.append(entities.getData(), entities.getDataSize());
     sendPacketToAllClients(packet, false);
 }
 
 void ECS::Network::sendRemovedComponentsToClients()
 {
     sf::Packet packet;
+    sf::Packet entities;
     int        nbEntities = 0;
     packet << static_cast<int>(PacketType::ClientUpdate);
     packet << static_cast<int>(UpdateType::RemoveComponents);
 
-    nbEntities = getNbEntitiesWithDeletedComponents();
-    packet << nbEntities;
+    EngineClass::getEngine().world().eachEntity([&](ECS::Entity *entity) {
+        if (addSerializedDeletedEntityToPacket(entities, entity)) nbEntities++;
+    });
     if (nbEntities == 0) return;
-    for (const auto &pair : EngineClass::getEngine().world().getEntities()) {
-        addSerializedDeletedEntityToPacket(packet, pair);
-    }
+    packet << nbEntities;
+    packet.append(entities.getData(), entities.getDataSize());
     sendPacketToAllClients(packet, false);
 }
 
 void ECS::Network::sendEventsToServer()
 {
-    sf::Packet packet;
-    int        nbEvents = clientEvents.size();
+    sf::Packet             packet;
+    std::vector<sf::Event> events;
+    sf::Event              event{};
 
-    if (nbEvents == 0) return;
+    if (clientEvents.empty()) return;
+    while (clientEvents.pop(event))
+        events.push_back(event);
 
     packet << static_cast<int>(PacketType::KeyInputs);
-    packet << nbEvents;
+    packet << static_cast<int>(events.size());
 
-    for (const auto &event : clientEvents) {
-        addSerializedEventToPacket(packet, event);
+    for (const auto &sentEvent : events) {
+        addSerializedEventToPacket(packet, sentEvent);
     }
-    clientEvents.clear();
     sendPacketToServer(packet);
 }
 
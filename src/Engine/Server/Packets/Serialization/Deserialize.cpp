@@ -56,17 +56,26 @@ sf::Event ECS::Network::deserializeEvent(sf::Packet &packet)
     return event;
 }
 
+/**
+ * @brief Decode a removed entity and queue it for the game loop.
+ *
+ * @param packet The packet, read up to the entity.
+ * @note The network threads never read the world, componentsUpdater() checks the entity on the game loop thread.
+ */
 void ECS::Network::deserializeRemoveEntitiesAndRemove(sf::Packet &packet)
 {
     sf::Uint64 entityId;
 
     packet >> entityId;
-    if (WORLD.entityExists(entityId)) {
-        componentsToUpdate.emplace_back(static_cast<ECS::id_t>(entityId), std::vector<ComponentType>(),
-                                        std::vector<std::pair<BaseComponent *, ComponentType>>());
-    }
+    componentsToUpdate.push({static_cast<ECS::id_t>(entityId), {}, {}});
 }
 
+/**
+ * @brief Decode the components of an entity and queue them for the game loop.
+ *
+ * @param packet The packet, read up to the entity.
+ * @note The components replacing existing ones are found by componentsUpdater(), on the game loop thread.
+ */
 void ECS::Network::deserializeEntityAndApply(sf::Packet &packet)
 {
     using namespace Engine::Components;
@@ -82,7 +91,9 @@ void ECS::Network::deserializeEntityAndApply(sf::Packet &packet)
     for (int i = 0; i < nbComponents; i++) {
         packet >> componentType;
         packet >> serialisedSize;
-        if (serialisedSize >= 0 && static_cast<std::size_t>(serialisedSize) <= packet.getDataSize()) {
+        if (componentsConvertor.isTag(static_cast<ComponentType>(componentType))) {
+            components.emplace_back(nullptr, static_cast<ComponentType>(componentType));
+        } else if (serialisedSize >= 0 && static_cast<std::size_t>(serialisedSize) <= packet.getDataSize()) {
             serialised.resize(serialisedSize);
             for (int j = 0; j < serialisedSize; ++j) {
                 sf::Uint8 dataByte;
@@ -96,35 +107,17 @@ void ECS::Network::deserializeEntityAndApply(sf::Packet &packet)
             std::cerr << "Invalid serialized data size" << std::endl;
         }
     }
-    if (Engine::EngineClass::getEngine().world().entityExists(entityId)) {
-        std::vector<ComponentType> componentsToRemove;
-        std::vector<ComponentType> currentEntityComponents;
-
-        for (auto &comp : Engine::EngineClass::getEngine().world().getMutEntity(entityId).getComponents())
-            currentEntityComponents.push_back(comp.second->getType());
-        for (auto &comp : components) {
-            for (auto &currentEntityComp : currentEntityComponents) {
-                if (comp.second == currentEntityComp) {
-                    componentsToRemove.push_back(currentEntityComp);
-                    break;
-                }
-            }
-        }
-        if (components.empty()) {
-            return;
-        } else
-            componentsToUpdate.emplace_back(entityId, componentsToRemove, components);
-        return;
-    }
-    if (components.empty()) {
-        return;
-    }
-    componentsToUpdate.emplace_back(entityId, std::vector<ComponentType>(), components);
+    if (components.empty()) return;
+    componentsToUpdate.push({entityId, {}, components});
 }
 
+/**
+ * @brief Decode the types removed from an entity and queue them for the game loop.
+ *
+ * @param packet The packet, read up to the entity.
+ */
 void ECS::Network::deserializeRemovedComponentsAndApply(sf::Packet &packet)
 {
-    using namespace Engine::Components;
     int                        nbComponents = 0;
     int                        componentType;
     sf::Uint64                 entityId;
@@ -134,19 +127,8 @@ void ECS::Network::deserializeRemovedComponentsAndApply(sf::Packet &packet)
     packet >> nbComponents;
     for (int i = 0; i < nbComponents; i++) {
         packet >> componentType;
-        if (!WORLD.entityExists(entityId)) continue;
-        ECS::Entity &entity = Engine::EngineClass::getEngine().world().getMutEntity(entityId);
-        for (auto &comp : entity.getComponents()) {
-            if (comp.second->getType() == static_cast<ComponentType>(componentType)) {
-                componentsToRemove.push_back(static_cast<ComponentType>(componentType));
-                break;
-            }
-        }
+        componentsToRemove.push_back(static_cast<ComponentType>(componentType));
     }
-    if (componentsToRemove.empty()) {
-        return;
-    }
-
-    componentsToUpdate.emplace_back(entityId, componentsToRemove,
-                                    std::vector<std::pair<BaseComponent *, ComponentType>>());
+    if (componentsToRemove.empty()) return;
+    componentsToUpdate.push({entityId, componentsToRemove, {}});
 }
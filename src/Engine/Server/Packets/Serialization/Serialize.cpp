@@ -62,58 +62,106 @@ void ECS::Network::addSerializedComponentToPacket(sf::Packet &packet, ECS::BaseC
             packet << static_cast<sf::Uint8>(byte);
         }
     }
-    component->setHasChanged(false);
 }
 
-void ECS::Network::addSerializedEntityToPacket(sf::Packet                                                     &packet,
-                                               const std::pair<const ECS::id_t, std::unique_ptr<ECS::Entity>> &pair)
+/**
+ * @brief Get the network types of the tags of an entity.
+ *
+ * @param entity The entity.
+ * @return std::vector<ComponentType> The types of its replicated tags, sent as a type with no data.
+ */
+static std::vector<ComponentType> getReplicatedTags(ECS::Entity *entity)
 {
-    int nbChangedComponents = 0;
+    std::vector<ComponentType> tags;
+    ECS::Signature             signature = entity->getSignature() & ECS::TagRegistry::getSignature();
 
-    if (pair.second == nullptr) return;
+    for (ECS::type_t type = 0; type < signature.size(); type++) {
+        if (!signature.test(type)) continue;
+        ComponentType componentType = ECS::TagRegistry::getComponentType(type);
+        if (componentType != ComponentType::NoneComponent) tags.push_back(componentType);
+    }
+    return tags;
+}
+
+/**
+ * @brief Write the components and tags of an entity changed after a tick.
+ *
+ * @param packet The packet to write to.
+ * @param entity The entity.
+ * @param sinceTick The change tick of the last replication.
+ * @return bool False if nothing of the entity changed, nothing is written then. The callers count the written
+ * entities to fill the header of the packet.
+ */
+bool ECS::Network::addSerializedEntityToPacket(sf::Packet &packet, ECS::Entity *entity, std::size_t sinceTick)
+{
+    int                        nbChangedComponents = 0;
+    std::vector<ComponentType> tags;
 
-    for (const auto &component : pair.second->getComponents()) {
-        if (component.second->getType() != ComponentType::NoneComponent && component.second->hasChanged()) {
+    if (entity == nullptr) return false;
+
+    for (const auto &component : entity->getComponents()) {
+        if (component && component->getType() != ComponentType::NoneComponent &&
+            component->hasChangedSince(sinceTick)) {
             nbChangedComponents++;
         }
     }
-    if (nbChangedComponents == 0) return;
+    if (entity->getTagsChangeTick() > sinceTick) tags = getReplicatedTags(entity);
+    nbChangedComponents += static_cast<int>(tags.size());
+    if (nbChangedComponents == 0) return false;
 
-    packet << static_cast<sf::Uint64>(pair.first);
+    packet << static_cast<sf::Uint64>(entity->getId());
     packet << nbChangedComponents;
-    for (const auto &component : pair.second->getComponents()) {
-        if (component.second->hasChanged()) {
-            if (component.second->getType() == ComponentType::NoneComponent) continue;
-            addSerializedComponentToPacket(packet, component.second.get());
+    for (const auto &component : entity->getComponents()) {
+        if (component && component->hasChangedSince(sinceTick)) {
+            if (component->getType() == ComponentType::NoneComponent) continue;
+            addSerializedComponentToPacket(packet, component.get());
         }
     }
+    for (ComponentType tag : tags) {
+        packet << static_cast<int>(tag);
+        packet << 0;
+    }
+    return true;
 }
 
-void ECS::Network::addSerializedDeletedEntityToPacket(
-    sf::Packet &packet, const std::pair<const ECS::id_t, std::unique_ptr<ECS::Entity>> &pair)
+/**
+ * @brief Write the components and tags removed from an entity and not added back since.
+ *
+ * @param packet The packet to write to.
+ * @param entity The entity.
+ * @return bool False if there is none, nothing is written then.
+ */
+bool ECS::Network::addSerializedDeletedEntityToPacket(sf::Packet &packet, ECS::Entity *entity)
 {
-    if (pair.second == nullptr) return;
+    if (entity == nullptr) return false;
 
-    int nbCompsToDelete = pair.second->getComponentsToDelete().size();
+    int nbCompsToDelete = entity->getComponentsToDelete().size();
 
-    for (const auto &component : pair.second->getComponents()) {
-        if (component.second->getType() != ComponentType::NoneComponent &&
-            std::find(pair.second->getComponentsToDelete().begin(), pair.second->getComponentsToDelete().end(),
-                      component.second->getType()) != pair.second->getComponentsToDelete().end()) {
+    for (const auto &component : entity->getComponents()) {
+        if (component && component->getType() != ComponentType::NoneComponent &&
+            std::find(entity->getComponentsToDelete().begin(), entity->getComponentsToDelete().end(),
+                      component->getType()) != entity->getComponentsToDelete().end()) {
             nbCompsToDelete--;
-            pair.second->getComponentsToDelete().erase(std::find(pair.second->getComponentsToDelete().begin(),
-                                                                 pair.second->getComponentsToDelete().end(),
-                                                                 component.second->getType()));
+            entity->getComponentsToDelete().erase(std::find(entity->getComponentsToDelete().begin(),
+                                                            entity->getComponentsToDelete().end(),
+                                                            component->getType()));
         }
     }
+    for (ComponentType tag : getReplicatedTags(entity)) {
+        auto deleted = std::find(entity->getComponentsToDelete().begin(), entity->getComponentsToDelete().end(), tag);
+        if (deleted == entity->getComponentsToDelete().end()) continue;
+        nbCompsToDelete--;
+        entity->getComponentsToDelete().erase(deleted);
+    }
     if (nbCompsToDelete <= 0) {
-        pair.second->getComponentsToDelete().clear();
-        return;
+        entity->getComponentsToDelete().clear();
+        return false;
     }
 
-    packet << static_cast<sf::Uint64>(pair.first);
+    packet << static_cast<sf::Uint64>(entity->getId());
     packet << nbCompsToDelete;
-    for (const auto &component : pair.second->getComponentsToDelete())
+    for (const auto &component : entity->getComponentsToDelete())
         packet << static_cast<int>(component);
-    pair.second->getComponentsToDelete().clear();
+    entity->getComponentsToDelete().clear();
+    return true;
 }
\ No newline at end of file
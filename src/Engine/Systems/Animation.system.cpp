@@ -36,30 +36,25 @@ static void animateSprite(ECS::ComponentHandle<Engine::Components::RenderableCom
 
 void AnimationSystem::tick()
 {
-    ECS::World                &world    = getWorld();
-    std::vector<ECS::Entity *> entities = world.getEntitiesWithComponents<Engine::Components::RenderableComponent,
-                                                                          Engine::Components::AnimationComponent>();
+    using namespace Engine::Components;
 
-    std::vector<ECS::Entity *> layeredEntities =
-        world.getEntitiesWithComponents<Engine::Components::LayeredRenderableComponent,
-                                        Engine::Components::LayeredAnimationComponent>();
+    ECS::World &world = getWorld();
 
-    for (auto &entity : entities) {
-        auto renderable = entity->getComponent<Engine::Components::RenderableComponent>();
-        auto animation  = entity->getComponent<Engine::Components::AnimationComponent>();
-        if (!renderable->isDisplayed || !animation->doAnimation) continue;
-        animateSprite(renderable, animation);
-    }
-    for (auto &entity : layeredEntities) {
-        auto renderables = entity->getComponent<Engine::Components::LayeredRenderableComponent>();
-        if (!renderables->isDisplayed) continue;
-        auto animations = entity->getComponent<Engine::Components::LayeredAnimationComponent>();
-
-        for (int i = 0; i < animations->layers; i++) {
-            if (!renderables->at(i)->isDisplayed || !animations->at(i)->doAnimation) continue;
-            auto animation  = animations->at(i);
-            auto renderable = renderables->at(i);
+    world.parallelEach<RenderableComponent, AnimationComponent>(
+        []([[maybe_unused]] ECS::Entity *entity, ECS::ComponentHandle<RenderableComponent> renderable,
+           ECS::ComponentHandle<AnimationComponent> animation) {
+            if (!renderable->isDisplayed || !animation->doAnimation) return;
             animateSprite(renderable, animation);
-        }
-    }
+        });
+    world.parallelEach<LayeredRenderableComponent, LayeredAnimationComponent>(
+        []([[maybe_unused]] ECS::Entity *entity, ECS::ComponentHandle<LayeredRenderableComponent> renderables,
+           ECS::ComponentHandle<LayeredAnimationComponent> animations) {
+            if (!renderables->isDisplayed) return;
+            for (int i = 0; i < animations->layers; i++) {
+                if (!renderables->at(i)->isDisplayed || !animations->at(i)->doAnimation) continue;
+                auto animation  = animations->at(i);
+                auto renderable = renderables->at(i);
+                animateSprite(renderable, animation);
+            }
+        });
 }
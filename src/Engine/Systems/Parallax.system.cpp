@@ -11,7 +11,6 @@
 #include "Engine/Components/Parallax.component.hpp"
 #include "Engine/Components/Position.component.hpp"
 #include "Engine/Components/Renderable.component.hpp"
-#include "Engine/Components/View.component.hpp"
 
 using namespace Engine::System;
 using namespace Engine::Components;
@@ -22,26 +21,17 @@ void ParallaxSystem::unconfigure() {}
 
 void ParallaxSystem::tick()
 {
-    ECS::World  &world      = getWorld();
-    sf::Vector2f windowSize = {0, 0};
-    sf::Vector2f viewCenter = {0, 0};
-
-    world.each<ViewComponent>(
-        [&windowSize, &viewCenter]([[maybe_unused]] ECS::Entity *entity, ECS::ComponentHandle<ViewComponent> viewComp) {
-            windowSize = viewComp->view.getSize();
-            viewCenter = viewComp->view.getCenter();
+    ECS::World &world = getWorld();
+
+    world.parallelEach<ParallaxComponent, PositionComponent, RenderableComponent>(
+        [&]([[maybe_unused]] ECS::Entity *entity, ParallaxComponent &parallaxComp, PositionComponent &positionComp,
+            RenderableComponent &renderable) {
+            sf::Vector2f renderableSize = {static_cast<float>(renderable.size.x),
+                                           static_cast<float>(renderable.size.y)};
+
+            if (positionComp.x + renderableSize.x <= 0) {
+                positionComp.x = renderableSize.x;
+            }
+            positionComp.x -= parallaxComp.speed;
         });
-
-    world.each<ParallaxComponent, PositionComponent,
-               RenderableComponent>([&]([[maybe_unused]] ECS::Entity             *entity,
-                                        ECS::ComponentHandle<ParallaxComponent>   parallaxComp,
-                                        ECS::ComponentHandle<PositionComponent>   positionComp,
-                                        ECS::ComponentHandle<RenderableComponent> renderable) {
-        sf::Vector2f renderableSize = {static_cast<float>(renderable->size.x), static_cast<float>(renderable->size.y)};
-
-        if (positionComp->x + renderableSize.x <= 0) {
-            positionComp->x = renderableSize.x;
-        }
-        positionComp->x -= parallaxComp->speed;
-    });
 }
@@ -9,6 +9,7 @@
 
 #include <SFML/Graphics/Rect.hpp>
 #include <SFML/Graphics/RectangleShape.hpp>
+#include <algorithm>
 
 #include "ECS/Components.hpp"
 #include "ECS/Entity.hpp"
@@ -122,44 +123,70 @@ void Physics::collide(ECS::Entity *entity, int x, int y)
 
     if (collisionEntities.empty()) return;
     for (auto &collisionEntity : collisionEntities)
-        world.broadcastEvent<CollisionEvent>({entity, collisionEntity});
+        world.queueEvent<CollisionEvent>({entity, collisionEntity});
 }
 
-void Physics::moveTime(ECS::Entity *entity, ECS::ComponentHandle<Components::MovingComponent> handle)
+/**
+ * @brief Compute the positions of a batch of moves.
+ *
+ * @param count The number of moves.
+ * @param elapsed, duration The time elapsed since the start of each move, and its duration.
+ * @param initialX, initialY, amountX, amountY The start position and the translation of each move.
+ * @param newX, newY Filled with the position of each entity.
+ * @param ended Filled with the number of axes that reached the end of their move.
+ * @note Plain arrays, restrict outputs and bitwise operators instead of && and || so there is no branch: the
+ * compiler vectorizes the loop (SSE/AVX at -O3) when it gets whole SoABuffer chunks.
+ */
+static void integrateMoves(std::size_t count, const float *elapsed, const float *duration, const float *initialX,
+                           const float *initialY, const float *amountX, const float *amountY, float *__restrict newX,
+                           float *__restrict newY, int *__restrict ended)
 {
-    using namespace Engine::Components;
+    for (std::size_t i = 0; i < count; i++) {
+        float progress = std::min(elapsed[i] / duration[i], 1.0f);
+        float endX     = initialX[i] + amountX[i];
+        float endY     = initialY[i] + amountY[i];
+        float x        = initialX[i] + amountX[i] * progress;
+        float y        = initialY[i] + amountY[i] * progress;
+        int   endedX   = ((amountX[i] > 0) & (x >= endX)) | ((amountX[i] < 0) & (x <= endX));
+        int   endedY   = ((amountY[i] > 0) & (y >= endY)) | ((amountY[i] < 0) & (y <= endY));
+
+        newX[i]  = endedX ? endX : x;
+        newY[i]  = endedY ? endY : y;
+        ended[i] = endedX + endedY;
+    }
+}
 
-    auto   now         = std::chrono::high_resolution_clock::now();
-    auto   epoch       = now.time_since_epoch();
-    size_t currentTime = std::chrono::duration_cast<std::chrono::milliseconds>(epoch).count();
+static std::size_t getCurrentTime()
+{
+    auto now   = std::chrono::high_resolution_clock::now();
+    auto epoch = now.time_since_epoch();
 
-    size_t       moveStartTime = handle->moveStartTime;
-    size_t       moveDuration  = handle->moveDuration;
-    sf::Vector2f initialPos    = handle->initialPos;
-    sf::Vector2f moveAmount    = handle->moveAmount;
+    return std::chrono::duration_cast<std::chrono::milliseconds>(epoch).count();
+}
 
-    size_t       elapsedTime = currentTime - moveStartTime;
-    double       progress    = std::min(static_cast<double>(elapsedTime) / static_cast<double>(moveDuration), 1.0);
-    sf::Vector2f newPosition = initialPos + moveAmount * static_cast<float>(progress);
+void Physics::moveTime(ECS::Entity *entity, ECS::ComponentHandle<Components::MovingComponent> handle)
+{
+    float        elapsed  = static_cast<float>(getCurrentTime() - handle->moveStartTime);
+    float        duration = static_cast<float>(handle->moveDuration);
+    sf::Vector2f newPosition;
+    int          endedMoveCounter = 0;
+
+    integrateMoves(1, &elapsed, &duration, &handle->initialPos.x, &handle->initialPos.y, &handle->moveAmount.x,
+                   &handle->moveAmount.y, &newPosition.x, &newPosition.y, &endedMoveCounter);
+    endMove(entity, newPosition, endedMoveCounter);
+}
 
-    int endedMoveCounter = 0;
+/**
+ * @brief Apply the result of a move to an entity.
+ *
+ * @param entity The moving entity.
+ * @param newPosition The position computed for the entity.
+ * @param endedMoveCounter The number of axes that reached the end of their move, the move is over at 2.
+ */
+void Physics::endMove(ECS::Entity *entity, sf::Vector2f newPosition, int endedMoveCounter)
+{
+    using namespace Engine::Components;
 
-    if (moveAmount.x > 0 && newPosition.x >= initialPos.x + moveAmount.x) {
-        newPosition.x = initialPos.x + moveAmount.x;
-        endedMoveCounter++;
-    }
-    if (moveAmount.y > 0 && newPosition.y >= initialPos.y + moveAmount.y) {
-        newPosition.y = initialPos.y + moveAmount.y;
-        endedMoveCounter++;
-    }
-    if (moveAmount.x < 0 && newPosition.x <= initialPos.x + moveAmount.x) {
-        newPosition.x = initialPos.x + moveAmount.x;
-        endedMoveCounter++;
-    }
-    if (moveAmount.y < 0 && newPosition.y <= initialPos.y + moveAmount.y) {
-        newPosition.y = initialPos.y + moveAmount.y;
-        endedMoveCounter++;
-    }
     if (!entity->has<PositionComponent>() || !entity->has<RenderableComponent>()) return;
     ECS::ComponentHandle<PositionComponent>   componentPos(entity->getComponent<PositionComponent>());
     ECS::ComponentHandle<RenderableComponent> renderableComponent(entity->getComponent<RenderableComponent>());
@@ -172,15 +199,37 @@ void Physics::moveTime(ECS::Entity *entity, ECS::ComponentHandle<Components::Mov
     componentPos->y = static_cast<int>(newPosition.y);
     renderableComponent->sprite.setPosition(newPosition);
 
-    if (endedMoveCounter == 2) entity->removeComponent<MovingComponent>(true);
+    if (endedMoveCounter == 2) getWorld().commands().removeComponent<MovingComponent>(entity->getId(), true);
 }
 
+/**
+ * @note The moves are gathered in a SoABuffer and computed chunk by chunk with integrateMoves(), the collisions and
+ * the writes then go entity by entity.
+ */
 void Physics::tick()
 {
     using namespace Engine::Components;
 
-    ECS::World &world = getWorld();
+    ECS::World &world       = getWorld();
+    std::size_t currentTime = getCurrentTime();
+
+    _moves.clear();
+    _movingEntities.clear();
+    world.each<MovingComponent>([&](ECS::Entity *entity, MovingComponent &moving) {
+        _movingEntities.push_back(entity);
+        _moves.push(static_cast<float>(currentTime - moving.moveStartTime), static_cast<float>(moving.moveDuration),
+                    moving.initialPos.x, moving.initialPos.y, moving.moveAmount.x, moving.moveAmount.y, 0, 0, 0);
+    });
+
+    for (std::size_t chunk = 0; chunk < _moves.chunkCount(); chunk++) {
+        integrateMoves(_moves.chunkSize(chunk), _moves.column<Elapsed>(chunk), _moves.column<Duration>(chunk),
+                       _moves.column<InitialX>(chunk), _moves.column<InitialY>(chunk), _moves.column<AmountX>(chunk),
+                       _moves.column<AmountY>(chunk), _moves.column<NewX>(chunk), _moves.column<NewY>(chunk),
+                       _moves.column<Ended>(chunk));
+    }
 
-    world.each<MovingComponent>(
-        [&](ECS::Entity *entity, ECS::ComponentHandle<MovingComponent> handle) { moveTime(entity, handle); });
+    for (std::size_t i = 0; i < _movingEntities.size(); i++) {
+        sf::Vector2f newPosition(_moves.get<NewX>(i), _moves.get<NewY>(i));
+        endMove(_movingEntities[i], newPosition, _moves.get<Ended>(i));
+    }
 }
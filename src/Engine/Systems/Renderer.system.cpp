@@ -26,14 +26,26 @@ void Renderer::configure([[maybe_unused]] ECS::World &world) {}
 
 void Renderer::unconfigure() {}
 
+/**
+ * @brief Place the sprite of a renderable at its entity position.
+ *
+ * @note The sprite keeps its transform from the previous frames, it is only set again when the entity moved or the
+ * renderable was rotated or scaled, so SFML does not recompute the transform of still sprites (and of every layer of
+ * a still LayeredRenderableComponent) on every frame.
+ */
 static void updateSprite(ECS::ComponentHandle<Engine::Components::RenderableComponent> renderable,
                          ECS::ComponentHandle<Engine::Components::PositionComponent>   positionComponent)
 {
-    renderable->sprite.setPosition(positionComponent->x, positionComponent->y);
-    renderable->sprite.setRotation(renderable->rotation);
-    renderable->sprite.setScale(renderable->scale);
+    sf::Vector2f position(positionComponent->x, positionComponent->y);
+
     renderable->size = {static_cast<std::size_t>(renderable->sprite.getTexture()->getSize().x * renderable->scale.x),
                         static_cast<std::size_t>(renderable->sprite.getTexture()->getSize().y * renderable->scale.y)};
+    if (renderable->sprite.getPosition() == position && renderable->sprite.getRotation() == renderable->rotation &&
+        renderable->sprite.getScale() == renderable->scale)
+        return;
+    renderable->sprite.setPosition(position);
+    renderable->sprite.setRotation(renderable->rotation);
+    renderable->sprite.setScale(renderable->scale);
 }
 
 void Renderer::tick()
@@ -46,15 +58,13 @@ void Renderer::tick()
     std::map<int, bool>                                                          keys{};
     std::map<int, bool>                                                          keys2{};
     sf::RenderWindow                                                            *window = &WINDOW;
-    std::unordered_map<ECS::Entity *, ECS::ComponentHandle<ViewComponent>>       ViewEntities;
+    ViewComponent                                                               *view   = nullptr;
 
-    ViewEntities = world.get<ViewComponent>();
-    if (ViewEntities.empty()) {
+    view = world.resource<ViewComponent>();
+    if (view == nullptr) {
         std::cerr << "ViewComponent missing, declare one" << std::endl;
     } else {
-        auto                                it            = ViewEntities.begin();
-        ECS::ComponentHandle<ViewComponent> viewComponent = it->second;
-        window->setView(viewComponent->view);
+        window->setView(view->view);
     }
 
     auto        r_entities = world.getEntitiesWithComponents<RenderableComponent>();
@@ -0,0 +1,60 @@
+/*
+** EPITECH PROJECT, 2024
+** B-CPP-500-LIL-5-2-rtype-ewen.sellitto
+** File description:
+** Transform.system.cpp
+*/
+
+#include "Engine/Systems/Transform.system.hpp"
+
+#include "ECS/World.hpp"
+#include "Engine/Components/Position.component.hpp"
+#include "Engine/Components/Transform.component.hpp"
+
+using namespace Engine::System;
+
+void Transform::configure([[maybe_unused]] ECS::World &world) {}
+
+void Transform::unconfigure() {}
+
+void Transform::tick()
+{
+    using namespace Engine::Components;
+
+    getWorld().eachHierarchyRoot([this](ECS::Entity *root) {
+        if (root->has<PositionComponent>()) updateChildren(root->getId(), *root->getComponent<PositionComponent>());
+    });
+}
+
+/**
+ * @brief Move the children of an entity to the position of the entity plus their offset, and recurse.
+ *
+ * @param parent The unique identifier of the entity.
+ * @param parentPosition The world position of the entity, already up to date.
+ * @note Positions already in place are not written, so the children of a still parent are not stamped as changed
+ * and are not sent to the clients again.
+ */
+void Transform::updateChildren(ECS::id_t parent, const Components::PositionComponent &parentPosition)
+{
+    using namespace Engine::Components;
+
+    ECS::World &world = getWorld();
+
+    for (ECS::id_t childId : world.getChildren(parent)) {
+        ECS::Entity &child = world.getMutEntity(childId);
+
+        if (!child.has<PositionComponent, TransformComponent>()) continue;
+
+        auto transform = child.getComponent<TransformComponent>();
+        auto position  = child.getComponent<PositionComponent>();
+        int  x         = parentPosition.x + transform->x;
+        int  y         = parentPosition.y + transform->y;
+
+        if (position->x != x || position->y != y) {
+            child.getComponent<PositionComponent>(true);
+            position->x = x;
+            position->y = y;
+        }
+        updateChildren(childId, *position);
+    }
+}
@@ -264,16 +264,13 @@ void UI::checkboxChangeRenderable(
     ECS::Entity *entity, ECS::ComponentHandle<Components::CheckBoxComponent> checkboxComp,
     [[maybe_unused]] const ECS::ComponentHandle<Components::RenderableComponent> &renderable)
 {
+    ECS::CommandBuffer &commands = getWorld().commands();
+    std::string         texture = checkboxComp->status ? "./assets/menu/button_check/check_on.png"
+                                               : "./assets/menu/button_check/check_off.png";
 
-    if (checkboxComp->status) {
-        entity->removeComponent<Components::RenderableComponent>();
-        entity->addComponent<Components::RenderableComponent>(new Components::RenderableComponent(
-            "./assets/menu/button_check/check_on.png", 0, 0, 3, 0, {2, 2}, false, true));
-    } else {
-        entity->removeComponent<Components::RenderableComponent>();
-        entity->addComponent<Components::RenderableComponent>(new Components::RenderableComponent(
-            "./assets/menu/button_check/check_off.png", 0, 0, 3, 0, {2, 2}, false, true));
-    }
+    commands.removeComponent<Components::RenderableComponent>(entity->getId());
+    commands.addComponent(entity->getId(),
+                          new Components::RenderableComponent(texture, 0, 0, 3, 0, {2, 2}, false, true));
 }
 
 void UI::handleKeyboard() {}
@@ -25,18 +25,15 @@ void WorldMoveSystem::tick()
 
     ECS::World &world = getWorld();
 
-    ECS::Entity *worldMoveEntity = world.getEntityWithComponents<WorldMoveProgressComponent>();
+    WorldMoveProgressComponent *progress = world.resource<WorldMoveProgressComponent>();
 
-    if (!worldMoveEntity) {
+    if (!progress) {
         return;
     }
 
-    ECS::ComponentHandle<WorldMoveProgressComponent> handle =
-        worldMoveEntity->getComponent<WorldMoveProgressComponent>();
-
     auto   now         = std::chrono::high_resolution_clock::now();
     auto   epoch       = now.time_since_epoch();
     size_t currentTime = std::chrono::duration_cast<std::chrono::milliseconds>(epoch).count();
 
-    handle->progress = static_cast<size_t>(((currentTime - handle->startingTime) * 50) / 1000);
+    progress->progress = static_cast<size_t>(((currentTime - progress->startingTime) * 50) / 1000);
 }